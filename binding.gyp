@@ -81,8 +81,16 @@
             'sources': [
                 'src/cpp/addon.cc',
                 'src/cpp/Log.cc',
+                'src/cpp/Arena.cc',
+                'src/cpp/Metadata.cc',
+                'src/cpp/ThreadPool.cc',
+                'src/cpp/Transcode.cc',
                 'src/cpp/nwrfcsdk.cc',
                 'src/cpp/Client.cc',
+                'src/cpp/Batch.cc',
+                'src/cpp/ParameterBuffer.cc',
+                'src/cpp/ResultBuffer.cc',
+                'src/cpp/TableCursor.cc',
                 'src/cpp/Pool.cc',
                 'src/cpp/Server.cc',
                 'src/cpp/server_api.cc',
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Arena.h"
+
+namespace node_rfc {
+
+Arena& Arena::local() {
+  static thread_local Arena arena;
+  return arena;
+}
+
+void* Arena::allocate(size_t size) {
+  // 8 bytes aligned
+  size = (size + 7) & ~static_cast<size_t>(7);
+
+  while (block < blocks.size()) {
+    if (offset + size <= blocks[block].size) {
+      void* ptr = blocks[block].data.get() + offset;
+      offset += size;
+      return ptr;
+    }
+    block++;
+    offset = 0;
+  }
+
+  size_t newSize = size > blockSize ? size : blockSize;
+  blocks.push_back({std::unique_ptr<char[]>(new char[newSize]), newSize});
+  block = blocks.size() - 1;
+  offset = size;
+  return blocks[block].data.get();
+}
+
+void Arena::release(Mark mark) {
+  block = mark.first;
+  offset = mark.second;
+
+  // Blocks larger than default are not kept for reuse
+  size_t used = offset > 0 ? block + 1 : block;
+  while (blocks.size() > used && blocks.back().size > blockSize) {
+    blocks.pop_back();
+  }
+}
+
+}  // namespace node_rfc
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_Arena_H
+#define NodeRfc_Arena_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace node_rfc {
+
+//
+// Bump allocator for temporary conversion buffers. One instance per thread,
+// memory released by ArenaScope and reused by the next conversion.
+//
+class Arena {
+ public:
+  typedef std::pair<size_t, size_t> Mark;  // block, offset
+
+  static Arena& local();
+
+  void* allocate(size_t size);
+  template <typename T>
+  T* alloc(size_t count) {
+    return static_cast<T*>(allocate(count * sizeof(T)));
+  }
+
+  Mark mark() const { return Mark(block, offset); }
+  void release(Mark mark);
+
+ private:
+  static const size_t blockSize = 64 * 1024;
+
+  typedef struct _Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  } Block;
+
+  std::vector<Block> blocks;
+  size_t block = 0;
+  size_t offset = 0;
+};
+
+//
+// Releases arena memory allocated in the scope
+//
+class ArenaScope {
+ public:
+  ArenaScope() : arena(Arena::local()), mark(arena.mark()) {}
+  ~ArenaScope() { arena.release(mark); }
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  template <typename T>
+  T* alloc(size_t count) {
+    return arena.alloc<T>(count);
+  }
+
+ private:
+  Arena& arena;
+  Arena::Mark mark;
+};
+
+}  // namespace node_rfc
+
+#endif
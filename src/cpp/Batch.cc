@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Batch.h"
+
+namespace node_rfc {
+
+bool checkBatch(Napi::Value batch) {
+  if (!batch.IsArray()) {
+    return false;
+  }
+  Napi::Array calls = batch.As<Napi::Array>();
+  for (uint_t i = 0; i < calls.Length(); i++) {
+    Napi::Value call = calls.Get(i);
+    if (!call.IsObject() ||
+        !call.As<Napi::Object>().Get(BATCH_KEY_RFM).IsString()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Napi::Value setNotRequested(RFC_FUNCTION_HANDLE functionHandle,
+                            Napi::Array notRequested) {
+  RFC_ERROR_INFO errorInfo;
+  for (uint_t i = 0; i < notRequested.Length(); i++) {
+    Napi::String name = notRequested.Get(i).ToString();
+    SAP_UC* paramName = setString(name);
+    RFC_RC rc = RfcSetParameterActive(functionHandle, paramName, 0, &errorInfo);
+    delete[] paramName;
+    if (rc != RFC_OK) {
+      return rfcSdkError(&errorInfo);
+    }
+  }
+  return notRequested.Env().Undefined();
+}
+
+Napi::Value prepareBatchCall(BatchCall* call,
+                             Napi::Object item,
+                             ClientOptionsStruct* client_options) {
+  Napi::Env env = item.Env();
+  Napi::EscapableHandleScope scope(env);
+  RFC_ERROR_INFO errorInfo;
+
+  call->parameters.reset(new ParameterBuffer());
+  call->functionHandle =
+      RfcCreateFunction(call->functionDesc->handle, &errorInfo);
+  if (errorInfo.code != RFC_OK) {
+    call->functionHandle = nullptr;
+    return scope.Escape(rfcSdkError(&errorInfo));
+  }
+
+  Napi::Value error = env.Undefined();
+  Napi::Value notRequested = item.Get(BATCH_KEY_NOTREQUESTED);
+  if (notRequested.IsArray()) {
+    error =
+        setNotRequested(call->functionHandle, notRequested.As<Napi::Array>());
+  }
+
+  if (error.IsUndefined()) {
+    Napi::Value params = item.Get(BATCH_KEY_PARAMS);
+    error = call->parameters->snapshot(call->functionDesc->handle,
+                                       params.IsObject()
+                                           ? params.As<Napi::Object>()
+                                           : Napi::Object::New(env),
+                                       &call->errorPath,
+                                       client_options);
+  }
+
+  if (!error.IsUndefined()) {
+    RfcDestroyFunction(call->functionHandle, nullptr);
+    call->functionHandle = nullptr;
+  } else {
+    call->resultBuffer.reset(new ResultBuffer());
+  }
+  return scope.Escape(error);
+}
+
+bool invokeBatchCall(BatchCall* call,
+                     RFC_CONNECTION_HANDLE connectionHandle,
+                     RFC_DIRECTION filter,
+                     uint_t bcd,
+                     int bcdScale) {
+  call->errorInfo.code = RFC_OK;
+  call->filled = call->parameters->fill(call->functionHandle);
+  if (!call->filled) {
+    return false;
+  }
+  RfcInvoke(connectionHandle, call->functionHandle, &call->errorInfo);
+  if (call->errorInfo.code != RFC_OK) {
+    return false;
+  }
+  // SDK data extracted here, NodeJS values created in main thread
+  call->resultBuffer->extract(call->functionDesc->handle,
+                              call->functionHandle,
+                              &call->errorPath,
+                              filter,
+                              bcd,
+                              bcdScale);
+  return true;
+}
+
+Napi::Value batchResult(Napi::Value error, Napi::Value result) {
+  Napi::Object item = Napi::Object::New(error.Env());
+  if (!error.IsUndefined()) {
+    item.Set("error", error);
+  } else {
+    item.Set("result", result);
+  }
+  return item;
+}
+
+Napi::Value wrapBatchCall(BatchCall* call,
+                          Napi::Value error,
+                          ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(error.Env());
+  ValuePair result = ValuePair(error, error.Env().Undefined());
+  if (result.first.IsUndefined() && !call->filled) {
+    result.first = call->parameters->error();
+  }
+  if (result.first.IsUndefined() && call->errorInfo.code != RFC_OK) {
+    result.first = rfcSdkError(&call->errorInfo);
+  }
+  if (result.first.IsUndefined()) {
+    result = call->resultBuffer->wrap(client_options);
+  }
+  if (call->functionHandle != nullptr) {
+    RfcDestroyFunction(call->functionHandle, nullptr);
+    call->functionHandle = nullptr;
+  }
+  return scope.Escape(batchResult(result.first, result.second));
+}
+
+}  // namespace node_rfc
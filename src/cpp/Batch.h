@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_Batch_H
+#define NodeRfc_Batch_H
+
+#include <memory>
+#include <vector>
+#include "Log.h"
+#include "Metadata.h"
+#include "ParameterBuffer.h"
+#include "ResultBuffer.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+ErrorPair connectionCheckErrorInit();
+
+//
+// One RFM call of Client invokeBatch() or Pool invokeParallel(),
+// prepared in the main thread, executed in worker thread
+//
+typedef struct _BatchCall {
+  uint_t index;  // in batch results
+  FunctionDescPtr functionDesc;
+  RFC_FUNCTION_HANDLE functionHandle = nullptr;
+  std::unique_ptr<ParameterBuffer> parameters;
+  std::unique_ptr<ResultBuffer> resultBuffer;
+  RfmErrorPath errorPath;
+  bool filled = false;
+  bool conn_closed = false;
+  RFC_ERROR_INFO errorInfo;
+  ErrorPair connectionCheckError = connectionCheckErrorInit();
+} BatchCall;
+
+typedef std::vector<BatchCall> BatchCalls;
+
+// Main thread, checks the array of {rfm, params, notRequested} objects
+bool checkBatch(Napi::Value batch);
+
+// Main thread, deactivates parameters not requested, returns the error
+// or undefined
+Napi::Value setNotRequested(RFC_FUNCTION_HANDLE functionHandle,
+                            Napi::Array notRequested);
+
+// Main thread, creates the function handle and parameters snapshot of the
+// batch item, returns the error or undefined
+Napi::Value prepareBatchCall(BatchCall* call,
+                             Napi::Object item,
+                             ClientOptionsStruct* client_options);
+
+// Worker thread, returns false if the call failed in SDK or ABAP
+bool invokeBatchCall(BatchCall* call,
+                     RFC_CONNECTION_HANDLE connectionHandle,
+                     RFC_DIRECTION filter,
+                     uint_t bcd,
+                     int bcdScale);
+
+// Main thread, returns batch result item with error or result set.
+// The function handle is destroyed.
+Napi::Value wrapBatchCall(BatchCall* call,
+                          Napi::Value error,
+                          ClientOptionsStruct* client_options);
+
+// Batch result item of the call failed in main thread
+Napi::Value batchResult(Napi::Value error, Napi::Value result);
+
+}  // namespace node_rfc
+
+#endif
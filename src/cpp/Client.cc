@@ -3,10 +3,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Client.h"
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <tuple>
+#include <vector>
+#include "Batch.h"
+#include "Metadata.h"
+#include "ParameterBuffer.h"
 #include "Pool.h"
+#include "ResultBuffer.h"
+#include "TableCursor.h"
 
 namespace node_rfc {
 
@@ -50,6 +57,7 @@ Napi::Object Client::Init(Napi::Env env, Napi::Object exports) {
               "_connectionHandle", &Client::ConnectionHandleGetter, nullptr),
           InstanceAccessor("_pool_id", &Client::PoolIdGetter, nullptr),
           InstanceAccessor("_config", &Client::ConfigGetter, nullptr),
+          InstanceAccessor("_queue", &Client::QueueGetter, nullptr),
           // InstanceMethod("setIniPath", &Client::SetIniPath),
           InstanceMethod("connectionInfo", &Client::ConnectionInfo),
           InstanceMethod("open", &Client::Open),
@@ -59,6 +67,8 @@ Napi::Object Client::Init(Napi::Env env, Napi::Object exports) {
           InstanceMethod("resetServerContext", &Client::ResetServerContext),
           InstanceMethod("ping", &Client::Ping),
           InstanceMethod("invoke", &Client::Invoke),
+          InstanceMethod("invokeStream", &Client::InvokeStream),
+          InstanceMethod("invokeBatch", &Client::InvokeBatch),
       });
 
   Napi::FunctionReference* constructor = new Napi::FunctionReference();
@@ -111,6 +121,18 @@ Napi::Value Client::PoolIdGetter(const Napi::CallbackInfo& info) {
   return Napi::Number::New(info.Env(), pool->id);
 }
 
+Napi::Value Client::QueueGetter(const Napi::CallbackInfo& info) {
+  Napi::EscapableHandleScope scope(info.Env());
+  Napi::Object queue = Napi::Object::New(info.Env());
+  queue.Set("active", Napi::Boolean::New(info.Env(), operationActive));
+  queue.Set("pending",
+            Napi::Number::New(info.Env(), (double)operations.size()));
+  queue.Set("maxPending", Napi::Number::New(info.Env(), (double)operationsMax));
+  queue.Set("completed",
+            Napi::Number::New(info.Env(), (double)operationsDone));
+  return scope.Escape(queue);
+}
+
 Napi::Value Client::ConnectionInfo(const Napi::CallbackInfo& info) {
   if (connectionHandle == nullptr) {
     return connectionClosedError("connectionInfo");
@@ -152,6 +174,12 @@ Client::Client(const Napi::CallbackInfo& info)
 };
 
 Client::~Client(void) {
+  // Operations not started are dropped with the client
+  for (RfcWorker* worker : operations) {
+    delete worker;
+  }
+  operations.clear();
+
   if (pool == nullptr) {
     // Close own connection
     if (connectionHandle != nullptr) {
@@ -197,10 +225,10 @@ Napi::Object Client::NewInstance(Napi::Env env) {
   return scope.Escape(napi_value(obj)).ToObject();
 }
 
-class OpenAsync : public Napi::AsyncWorker {
+class OpenAsync : public RfcWorker {
  public:
   OpenAsync(Napi::Function& callback, Client* client)
-      : Napi::AsyncWorker(callback), client(client) {}
+      : RfcWorker(callback), client(client) {}
   ~OpenAsync() {}
 
   // cppcheck-suppress unusedFunction
@@ -218,6 +246,7 @@ class OpenAsync : public Napi::AsyncWorker {
 
   // cppcheck-suppress unusedFunction
   void OnOK() {
+    client->dequeue();
     if (errorInfo.code != RFC_OK) {
       Callback().Call({rfcSdkError(&errorInfo)});
     } else {
@@ -231,10 +260,10 @@ class OpenAsync : public Napi::AsyncWorker {
   RFC_ERROR_INFO errorInfo;
 };
 
-class CloseAsync : public Napi::AsyncWorker {
+class CloseAsync : public RfcWorker {
  public:
   CloseAsync(Napi::Function& callback, Client* client)
-      : Napi::AsyncWorker(callback), client(client) {}
+      : RfcWorker(callback), client(client) {}
   ~CloseAsync() {}
 
   void Execute() {
@@ -249,6 +278,7 @@ class CloseAsync : public Napi::AsyncWorker {
 
   void OnOK() {
     Napi::HandleScope scope(Env());
+    client->dequeue();
 
     if (conn_closed) {
       Callback().Call({client->connectionClosedError("close()")});
@@ -266,10 +296,10 @@ class CloseAsync : public Napi::AsyncWorker {
   bool conn_closed = false;
 };
 
-class ResetServerAsync : public Napi::AsyncWorker {
+class ResetServerAsync : public RfcWorker {
  public:
   ResetServerAsync(Napi::Function& callback, Client* client)
-      : Napi::AsyncWorker(callback), client(client) {}
+      : RfcWorker(callback), client(client) {}
   ~ResetServerAsync() {}
 
   void Execute() {
@@ -286,6 +316,7 @@ class ResetServerAsync : public Napi::AsyncWorker {
 
   void OnOK() {
     Napi::HandleScope scope(Env());
+    client->dequeue();
     Napi::Value error = client->getOperationError(conn_closed,
                                                   "resetServerContext()",
                                                   connectionCheckError,
@@ -302,10 +333,10 @@ class ResetServerAsync : public Napi::AsyncWorker {
   ErrorPair connectionCheckError = connectionCheckErrorInit();
 };
 
-class PingAsync : public Napi::AsyncWorker {
+class PingAsync : public RfcWorker {
  public:
   PingAsync(Napi::Function& callback, Client* client)
-      : Napi::AsyncWorker(callback), client(client) {}
+      : RfcWorker(callback), client(client) {}
   ~PingAsync() {}
 
   void Execute() {
@@ -322,6 +353,7 @@ class PingAsync : public Napi::AsyncWorker {
 
   void OnOK() {
     Napi::HandleScope scope(Env());
+    client->dequeue();
     Napi::Value error = client->getOperationError(
         conn_closed, "ping()", connectionCheckError, &errorInfo, Env());
     Callback().Call({error, Napi::Boolean::New(Env(), error.IsUndefined())});
@@ -335,36 +367,57 @@ class PingAsync : public Napi::AsyncWorker {
   ErrorPair connectionCheckError = connectionCheckErrorInit();
 };
 
-class InvokeAsync : public Napi::AsyncWorker {
+class InvokeAsync : public RfcWorker {
  public:
   InvokeAsync(Napi::Function& callback,
               Client* client,
               RFC_FUNCTION_HANDLE functionHandle,
-              RFC_FUNCTION_DESC_HANDLE functionDescHandle)
-      : Napi::AsyncWorker(callback),
+              FunctionDescPtr functionDesc,
+              std::unique_ptr<ParameterBuffer> parameters,
+              RfmErrorPath* errorPath,
+              bool stream)
+      : RfcWorker(callback),
         client(client),
         functionHandle(functionHandle),
-        functionDescHandle(functionDescHandle) {}
+        functionDesc(functionDesc),
+        parameters(std::move(parameters)),
+        stream(stream),
+        errorPath(*errorPath),
+        filter(client->client_options.filter_param_type),
+        bcd(client->client_options.bcd),
+        bcdScale(client->client_options.bcdScale) {}
   ~InvokeAsync() {}
 
   void Execute() {
+    // NodeJS parameters snapshot set here, not in the main thread
+    filled = parameters->fill(functionHandle);
+    errorInfo.code = RFC_OK;
+
     client->LockMutex();
     conn_closed = (client->connectionHandle == nullptr);
-    if (!conn_closed) {
+    if (!conn_closed && filled) {
       RfcInvoke(client->connectionHandle, functionHandle, &errorInfo);
       if (errorInfo.code != RFC_OK) {
         connectionCheckError = client->connectionCheck(&errorInfo);
+      } else if (!stream) {
+        // SDK data extracted here, NodeJS values created in OnOK
+        resultBuffer.extract(functionDesc->handle,
+                             functionHandle,
+                             &errorPath,
+                             filter,
+                             bcd,
+                             bcdScale);
       }
     }
+    client->UnlockMutex();
   }
 
   void OnOK() {
     Napi::HandleScope scope(Env());
 
     std::string closed_errmsg =
-        "invoke() " + wrapString(client->errorPath.functionName)
-                          .As<Napi::String>()
-                          .Utf8Value();
+        "invoke() " +
+        wrapString(errorPath.functionName).As<Napi::String>().Utf8Value();
     ValuePair result =
         ValuePair(client->getOperationError(conn_closed,
                                             closed_errmsg.c_str(),
@@ -373,15 +426,25 @@ class InvokeAsync : public Napi::AsyncWorker {
                                             Env()),
                   Env().Undefined());
 
-    if (result.first.IsUndefined()) {
-      result = getRfmParameters(functionDescHandle,
-                                functionHandle,
-                                &client->errorPath,
-                                &client->client_options);
+    if (result.first.IsUndefined() && !filled) {
+      result.first = parameters->error();
     }
 
-    RfcDestroyFunction(functionHandle, nullptr);
-    client->UnlockMutex();
+    if (result.first.IsUndefined() && stream) {
+      // tables are read by the cursor, after the connection is released
+      result = TableCursor::NewInstance(functionHandle,
+                                        functionDesc,
+                                        &errorPath,
+                                        &client->client_options);
+      functionHandle = nullptr;
+    } else if (result.first.IsUndefined()) {
+      result = resultBuffer.wrap(&client->client_options);
+    }
+
+    if (functionHandle != nullptr) {
+      RfcDestroyFunction(functionHandle, nullptr);
+    }
+    client->dequeue();
 
     Callback().Call({result.first, result.second});
     Callback().Reset();
@@ -390,39 +453,78 @@ class InvokeAsync : public Napi::AsyncWorker {
  private:
   Client* client;
   RFC_FUNCTION_HANDLE functionHandle;
-  RFC_FUNCTION_DESC_HANDLE functionDescHandle;
+  FunctionDescPtr functionDesc;
+  std::unique_ptr<ParameterBuffer> parameters;
+  bool filled = false;
+  bool stream;
+  RfmErrorPath errorPath;
+  RFC_DIRECTION filter;
+  uint_t bcd;
+  int bcdScale;
+  ResultBuffer resultBuffer;
   RFC_ERROR_INFO errorInfo;
   bool conn_closed = false;
   ErrorPair connectionCheckError = connectionCheckErrorInit();
 };
 
-class PrepareAsync : public Napi::AsyncWorker {
+//
+// Invoke error found in the main thread, returned in the order of client
+// operations
+//
+class InvokeErrorAsync : public RfcWorker {
+ public:
+  InvokeErrorAsync(Napi::Function& callback, Client* client, Napi::Value error)
+      : RfcWorker(callback),
+        client(client),
+        error(Napi::Persistent(error)) {}
+  ~InvokeErrorAsync() {}
+
+  void Execute() {}
+
+  void OnOK() {
+    Napi::HandleScope scope(Env());
+    Napi::Value errorValue = error.Value();
+    error.Reset();
+    client->dequeue();
+    Callback().Call({errorValue, Env().Undefined()});
+    Callback().Reset();
+  }
+
+ private:
+  Client* client;
+  Napi::Reference<Napi::Value> error;
+};
+
+class PrepareAsync : public RfcWorker {
  public:
   PrepareAsync(Napi::Function& callback,
                Client* client,
                Napi::String rfmName,
                Napi::Array& notRequestedParameters,
-               Napi::Object& rfmParams)
-      : Napi::AsyncWorker(callback),
+               Napi::Object& rfmParams,
+               bool stream)
+      : RfcWorker(callback),
         client(client),
         notRequested(Napi::Persistent(notRequestedParameters)),
-        rfmParams(Napi::Persistent(rfmParams)) {
+        rfmParams(Napi::Persistent(rfmParams)),
+        stream(stream) {
     funcName = setString(rfmName);
-    client->errorPath.setFunctionName(funcName);
   }
   ~PrepareAsync() { delete[] funcName; }
 
   void Execute() {
+    // set when dequeued, the previous call may still use the error path
+    client->errorPath.setFunctionName(funcName);
     client->LockMutex();
     conn_closed = (client->connectionHandle == nullptr);
     if (!conn_closed) {
-      functionDescHandle =
-          RfcGetFunctionDesc(client->connectionHandle, funcName, &errorInfo);
+      functionDesc = _metadata.getFunctionDesc(
+          client->connectionHandle, funcName, &errorInfo, &cacheKey);
     }
+    client->UnlockMutex();
   }
 
   void OnOK() {
-    client->UnlockMutex();
     RFC_FUNCTION_HANDLE functionHandle = nullptr;
     Napi::Value argv[2] = {Env().Undefined(), Env().Undefined()};
 
@@ -432,60 +534,50 @@ class PrepareAsync : public Napi::AsyncWorker {
                             .As<Napi::String>()
                             .Utf8Value();
       argv[0] = client->connectionClosedError(errmsg.c_str());
-    } else if (functionDescHandle == nullptr || errorInfo.code != RFC_OK) {
+    } else if (functionDesc == nullptr || errorInfo.code != RFC_OK) {
       argv[0] = rfcSdkError(&errorInfo);
     } else {
+      // next calls of this client find cached descriptors in main thread
+      client->repository = cacheKey;
+
       // function descriptor handle created, proceed with function handle
-      functionHandle = RfcCreateFunction(functionDescHandle, &errorInfo);
+      functionHandle = RfcCreateFunction(functionDesc->handle, &errorInfo);
 
       if (errorInfo.code != RFC_OK) {
         argv[0] = rfcSdkError(&errorInfo);
       } else {
-        for (uint_t i = 0; i < notRequested.Value().Length(); i++) {
-          Napi::String name = notRequested.Value().Get(i).ToString();
-          SAP_UC* paramName = setString(name);
-          RFC_RC rc =
-              RfcSetParameterActive(functionHandle, paramName, 0, &errorInfo);
-          delete[] paramName;
-          if (rc != RFC_OK) {
-            argv[0] = rfcSdkError(&errorInfo);
-            break;
-          }
-        }
+        argv[0] = setNotRequested(functionHandle, notRequested.Value());
       }
     }
 
     notRequested.Reset();
 
+    std::unique_ptr<ParameterBuffer> parameters(new ParameterBuffer());
     if (argv[0].IsUndefined()) {
-      Napi::Object params = rfmParams.Value();
-      Napi::Array paramNames = params.GetPropertyNames();
-      uint_t paramSize = paramNames.Length();
-
-      for (uint_t i = 0; i < paramSize; i++) {
-        Napi::String name = paramNames.Get(i).ToString();
-        Napi::Value value = params.Get(name);
-        argv[0] = setRfmParameter(functionDescHandle,
-                                  functionHandle,
-                                  name,
-                                  value,
-                                  &client->errorPath,
-                                  &client->client_options);
-
-        if (!argv[0].IsUndefined()) {
-          break;
-        }
-      }
+      argv[0] = parameters->snapshot(functionDesc->handle,
+                                     rfmParams.Value(),
+                                     &client->errorPath,
+                                     &client->client_options);
     }
 
     rfmParams.Reset();
 
     if (argv[0].IsUndefined()) {
+      // queue slot kept by the client, until the invoke is done
       Napi::Function callbackFunction = Callback().Value().As<Napi::Function>();
-      (new InvokeAsync(
-           callbackFunction, client, functionHandle, functionDescHandle))
+      (new InvokeAsync(callbackFunction,
+                       client,
+                       functionHandle,
+                       functionDesc,
+                       std::move(parameters),
+                       &client->errorPath,
+                       stream))
           ->Queue();
     } else {
+      if (functionHandle != nullptr) {
+        RfcDestroyFunction(functionHandle, nullptr);
+      }
+      client->dequeue();
       Callback().Call({argv[0], argv[1]});
       Callback().Reset();
     }
@@ -497,12 +589,166 @@ class PrepareAsync : public Napi::AsyncWorker {
 
   Napi::Reference<Napi::Array> notRequested;
   Napi::Reference<Napi::Object> rfmParams;
+  bool stream;
 
-  RFC_FUNCTION_DESC_HANDLE functionDescHandle;
+  FunctionDescPtr functionDesc;
+  FunctionDescKey cacheKey;
   RFC_ERROR_INFO errorInfo;
   bool conn_closed = false;
 };
 
+class InvokeBatchAsync : public RfcWorker {
+ public:
+  InvokeBatchAsync(Napi::Function& callback,
+                   Client* client,
+                   BatchCalls calls,
+                   Napi::Array results)
+      : RfcWorker(callback),
+        client(client),
+        calls(std::move(calls)),
+        results(Napi::Persistent(results)),
+        filter(client->client_options.filter_param_type),
+        bcd(client->client_options.bcd),
+        bcdScale(client->client_options.bcdScale) {}
+  ~InvokeBatchAsync() {}
+
+  void Execute() {
+    // calls run one after another, in the same ABAP session
+    for (BatchCall& call : calls) {
+      client->LockMutex();
+      call.conn_closed = (client->connectionHandle == nullptr);
+      if (!call.conn_closed &&
+          !invokeBatchCall(
+              &call, client->connectionHandle, filter, bcd, bcdScale) &&
+          call.errorInfo.code != RFC_OK) {
+        call.connectionCheckError = client->connectionCheck(&call.errorInfo);
+      }
+      client->UnlockMutex();
+    }
+  }
+
+  void OnOK() {
+    Napi::HandleScope scope(Env());
+
+    for (BatchCall& call : calls) {
+      std::string closed_errmsg =
+          "invokeBatch() " + wrapString(call.errorPath.functionName)
+                                 .As<Napi::String>()
+                                 .Utf8Value();
+      Napi::Value error = client->getOperationError(call.conn_closed,
+                                                    closed_errmsg.c_str(),
+                                                    call.connectionCheckError,
+                                                    &call.errorInfo,
+                                                    Env());
+      results.Value().Set(
+          call.index, wrapBatchCall(&call, error, &client->client_options));
+    }
+    client->dequeue();
+
+    Callback().Call({Env().Undefined(), results.Value()});
+    Callback().Reset();
+    results.Reset();
+  }
+
+ private:
+  Client* client;
+  BatchCalls calls;
+  Napi::Reference<Napi::Array> results;
+  RFC_DIRECTION filter;
+  uint_t bcd;
+  int bcdScale;
+};
+
+class PrepareBatchAsync : public RfcWorker {
+ public:
+  PrepareBatchAsync(Napi::Function& callback,
+                    Client* client,
+                    Napi::Array& batch)
+      : RfcWorker(callback), client(client), batch(Napi::Persistent(batch)) {
+    for (uint_t i = 0; i < batch.Length(); i++) {
+      Napi::Object call = batch.Get(i).As<Napi::Object>();
+      funcNames.push_back(
+          setString(call.Get(BATCH_KEY_RFM).As<Napi::String>()));
+    }
+    functionDescs.resize(funcNames.size());
+    errorInfos.resize(funcNames.size());
+  }
+  ~PrepareBatchAsync() {
+    for (SAP_UC* funcName : funcNames) {
+      delete[] funcName;
+    }
+  }
+
+  void Execute() {
+    // function descriptors of all calls read at once
+    client->LockMutex();
+    conn_closed = (client->connectionHandle == nullptr);
+    for (size_t i = 0; i < funcNames.size() && !conn_closed; i++) {
+      errorInfos[i].code = RFC_OK;
+      functionDescs[i] = _metadata.getFunctionDesc(
+          client->connectionHandle, funcNames[i], &errorInfos[i]);
+    }
+    client->UnlockMutex();
+  }
+
+  void OnOK() {
+    Napi::HandleScope scope(Env());
+    Napi::Array results = Napi::Array::New(Env(), funcNames.size());
+    BatchCalls calls;
+
+    for (uint_t i = 0; i < funcNames.size(); i++) {
+      BatchCall call;
+      call.index = i;
+      call.functionDesc = functionDescs[i];
+      call.errorPath.setFunctionName(funcNames[i]);
+
+      Napi::Value error;
+      if (conn_closed) {
+        std::string errmsg = "invokeBatch() " +
+                             wrapString(call.errorPath.functionName)
+                                 .As<Napi::String>()
+                                 .Utf8Value();
+        error = client->connectionClosedError(errmsg.c_str());
+      } else if (call.functionDesc == nullptr ||
+                 errorInfos[i].code != RFC_OK) {
+        error = rfcSdkError(&errorInfos[i]);
+      } else {
+        error = prepareBatchCall(&call,
+                                 batch.Value().Get(i).As<Napi::Object>(),
+                                 &client->client_options);
+      }
+
+      if (!error.IsUndefined()) {
+        results.Set(i, batchResult(error, Env().Undefined()));
+      } else {
+        calls.push_back(std::move(call));
+      }
+    }
+
+    batch.Reset();
+
+    if (calls.empty()) {
+      client->dequeue();
+      Callback().Call({Env().Undefined(), results});
+      Callback().Reset();
+      return;
+    }
+
+    // queue slot kept by the client, until all calls are done
+    Napi::Function callbackFunction = Callback().Value().As<Napi::Function>();
+    (new InvokeBatchAsync(callbackFunction, client, std::move(calls), results))
+        ->Queue();
+  }
+
+ private:
+  Client* client;
+  Napi::Reference<Napi::Array> batch;
+  std::vector<SAP_UC*> funcNames;
+  std::vector<FunctionDescPtr> functionDescs;
+  std::vector<RFC_ERROR_INFO> errorInfos;
+  bool conn_closed = false;
+};
+
 ErrorPair Client::connectionCheck(RFC_ERROR_INFO* errorInfo) {
   RFC_ERROR_INFO errorInfoOpen;
 
@@ -670,7 +916,7 @@ Napi::Value Client::Open(const Napi::CallbackInfo& info) {
     return info.Env().Undefined();
   }
 
-  (new OpenAsync(callback, this))->Queue();
+  enqueue((new OpenAsync(callback, this)));
 
   return info.Env().Undefined();
 }
@@ -694,7 +940,7 @@ Napi::Value Client::Close(const Napi::CallbackInfo& info) {
     return info.Env().Undefined();
   }
 
-  (new CloseAsync(callback, this))->Queue();
+  enqueue((new CloseAsync(callback, this)));
 
   return info.Env().Undefined();
 }
@@ -708,7 +954,7 @@ Napi::Value Client::ResetServerContext(const Napi::CallbackInfo& info) {
   }
   Napi::Function callback = info[0].As<Napi::Function>();
 
-  (new ResetServerAsync(callback, this))->Queue();
+  enqueue((new ResetServerAsync(callback, this)));
 
   return info.Env().Undefined();
 }
@@ -723,12 +969,20 @@ Napi::Value Client::Ping(const Napi::CallbackInfo& info) {
 
   Napi::Function callback = info[0].As<Napi::Function>();
 
-  (new PingAsync(callback, this))->Queue();
+  enqueue((new PingAsync(callback, this)));
 
   return info.Env().Undefined();
 }
 
 Napi::Value Client::Invoke(const Napi::CallbackInfo& info) {
+  return invoke(info, false);
+}
+
+Napi::Value Client::InvokeStream(const Napi::CallbackInfo& info) {
+  return invoke(info, true);
+}
+
+Napi::Value Client::invoke(const Napi::CallbackInfo& info, bool stream) {
   Napi::Array notRequested = Napi::Array::New(info.Env());
   Napi::Value bcd;
 
@@ -764,11 +1018,112 @@ Napi::Value Client::Invoke(const Napi::CallbackInfo& info) {
   Napi::String rfmName = info[0].As<Napi::String>();
   Napi::Object rfmParams = info[1].As<Napi::Object>();
 
-  (new PrepareAsync(callback, this, rfmName, notRequested, rfmParams))->Queue();
+  if (!invokeCached(callback, rfmName, notRequested, rfmParams, stream)) {
+    enqueue(new PrepareAsync(
+        callback, this, rfmName, notRequested, rfmParams, stream));
+  }
+
+  return info.Env().Undefined();
+}
+
+bool Client::invokeCached(Napi::Function& callback,
+                          Napi::String rfmName,
+                          Napi::Array notRequested,
+                          Napi::Object rfmParams,
+                          bool stream) {
+  // Descriptor cached: parameters snapshot taken now and the call executed
+  // in one worker job, without the PrepareAsync round trip
+  RfmErrorPath callErrorPath;
+  SAP_UC* funcName = setString(rfmName);
+  callErrorPath.setFunctionName(funcName);
+  FunctionDescPtr functionDesc =
+      _metadata.findFunctionDesc(repository, funcName);
+  delete[] funcName;
+  if (functionDesc == nullptr) {
+    return false;
+  }
+
+  RFC_ERROR_INFO errorInfo;
+  std::unique_ptr<ParameterBuffer> parameters(new ParameterBuffer());
+  Napi::Value error = Env().Undefined();
+  RFC_FUNCTION_HANDLE functionHandle =
+      RfcCreateFunction(functionDesc->handle, &errorInfo);
+  if (errorInfo.code != RFC_OK) {
+    functionHandle = nullptr;
+    error = rfcSdkError(&errorInfo);
+  } else {
+    error = setNotRequested(functionHandle, notRequested);
+  }
+  if (error.IsUndefined()) {
+    error = parameters->snapshot(
+        functionDesc->handle, rfmParams, &callErrorPath, &client_options);
+  }
+  if (!error.IsUndefined()) {
+    // parameters not converted again, the error is queued
+    if (functionHandle != nullptr) {
+      RfcDestroyFunction(functionHandle, nullptr);
+    }
+    enqueue(new InvokeErrorAsync(callback, this, error));
+    return true;
+  }
+
+  enqueue(new InvokeAsync(callback,
+                          this,
+                          functionHandle,
+                          functionDesc,
+                          std::move(parameters),
+                          &callErrorPath,
+                          stream));
+  return true;
+}
+
+Napi::Value Client::InvokeBatch(const Napi::CallbackInfo& info) {
+  if (!info[1].IsFunction()) {
+    Napi::TypeError::New(info.Env(),
+                         "Client invokeBatch() requires a callback function")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  Napi::Function callback = info[1].As<Napi::Function>();
+
+  if (!checkBatch(info[0])) {
+    Napi::TypeError::New(info.Env(),
+                         "Client invokeBatch() requires an array of "
+                         "{rfm, params} objects")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  Napi::Array batch = info[0].As<Napi::Array>();
+  enqueue(new PrepareBatchAsync(callback, this, batch));
 
   return info.Env().Undefined();
 }
 
+void Client::enqueue(RfcWorker* worker) {
+  if (operationActive) {
+    operations.push_back(worker);
+    if (operations.size() > operationsMax) {
+      operationsMax = operations.size();
+    }
+    return;
+  }
+  operationActive = true;
+  worker->Queue();
+}
+
+void Client::dequeue() {
+  operationsDone++;
+  if (operations.empty()) {
+    operationActive = false;
+    return;
+  }
+  RfcWorker* worker = operations.front();
+  operations.pop_front();
+  worker->Queue();
+}
+
 void Client::LockMutex() {
   invocationMutex.lock();
 }
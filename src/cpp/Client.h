@@ -5,7 +5,10 @@
 #ifndef NodeRfc_Client_H
 #define NodeRfc_Client_H
 
+#include <deque>
 #include "Log.h"
+#include "Metadata.h"
+#include "ThreadPool.h"
 #include "nwrfcsdk.h"
 
 namespace node_rfc {
@@ -27,6 +30,9 @@ class Client : public Napi::ObjectWrap<Client> {
   friend class PingAsync;
   friend class PrepareAsync;
   friend class InvokeAsync;
+  friend class InvokeErrorAsync;
+  friend class PrepareBatchAsync;
+  friend class InvokeBatchAsync;
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   // cppcheck-suppress noExplicitConstructor
   Client(const Napi::CallbackInfo& info);
@@ -40,6 +46,7 @@ class Client : public Napi::ObjectWrap<Client> {
   Napi::Value ConfigGetter(const Napi::CallbackInfo& info);
   Napi::Value ConnectionHandleGetter(const Napi::CallbackInfo& info);
   Napi::Value PoolIdGetter(const Napi::CallbackInfo& info);
+  Napi::Value QueueGetter(const Napi::CallbackInfo& info);
   Napi::ObjectReference clientParamsRef;
   Napi::ObjectReference clientOptionsRef;
 
@@ -59,9 +66,21 @@ class Client : public Napi::ObjectWrap<Client> {
   Napi::Value ResetServerContext(const Napi::CallbackInfo& info);
   Napi::Value Ping(const Napi::CallbackInfo& info);
   Napi::Value Invoke(const Napi::CallbackInfo& info);
+  Napi::Value InvokeStream(const Napi::CallbackInfo& info);
+  Napi::Value InvokeBatch(const Napi::CallbackInfo& info);
+  Napi::Value invoke(const Napi::CallbackInfo& info, bool stream);
+  bool invokeCached(Napi::Function& callback,
+                    Napi::String rfmName,
+                    Napi::Array notRequested,
+                    Napi::Object rfmParams,
+                    bool stream);
 
   RfmErrorPath errorPath;
 
+  // ABAP system and client of the connection, set in the main thread
+  // after the first function descriptor read
+  FunctionDescKey repository;
+
   void init() {
     id = Client::_id++;
 
@@ -72,6 +91,16 @@ class Client : public Napi::ObjectWrap<Client> {
   static uint_t _id;
   std::mutex invocationMutex;
 
+  // Client operations run one at a time, in the order requested. Waiting
+  // operations are queued here, in the main thread, instead of blocking
+  // libuv worker threads on the invocation mutex.
+  void enqueue(RfcWorker* worker);
+  void dequeue();
+  std::deque<RfcWorker*> operations;
+  bool operationActive = false;
+  size_t operationsMax = 0;
+  uint64_t operationsDone = 0;
+
   uint_t id;
   Pool* pool;
   RFC_CONNECTION_HANDLE connectionHandle;
@@ -0,0 +1,456 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Metadata.h"
+#include <vector>
+
+namespace node_rfc {
+
+// SAP unicode string as cache key bytes
+std::string ucKey(const SAP_UC* uc) {
+  return std::string(reinterpret_cast<const char*>(uc),
+                     strlenU(uc) * sizeof(SAP_UC));
+}
+
+// Cache key bytes to SAP unicode string
+void ucFromKey(const std::string& key, SAP_UC* uc) {
+  uint_t len = key.length() / sizeof(SAP_UC);
+  memcpy(uc, key.data(), len * sizeof(SAP_UC));
+  uc[len] = 0;
+}
+
+// SAP unicode ABAP name to UTF-8 binding plan key
+std::string ucToUtf8(const SAP_UC* uc) {
+  RFC_ERROR_INFO errorInfo;
+  uint_t ucLength = strlenU(uc);
+  uint_t utf8Size = ucLength * 3 + 1;
+  uint_t resultLength = 0;
+  std::string utf8(utf8Size, 0);
+  RfcSAPUCToUTF8(uc,
+                 ucLength,
+                 reinterpret_cast<RFC_BYTE*>(&utf8[0]),
+                 &utf8Size,
+                 &resultLength,
+                 &errorInfo);
+  utf8.resize(resultLength);
+  return utf8;
+}
+
+const FieldBinding* BindingPlan::find(const std::string& name,
+                                      RFC_ERROR_INFO* errorInfo) const {
+  auto it = names.find(name);
+  if (it != names.end()) {
+    return &fields[it->second];
+  }
+
+  // Not found, the SDK lookup by name provides the error
+  RFC_RC rc;
+  SAP_UC* cName = setString(name);
+  if (functionDescHandle != nullptr) {
+    RFC_PARAMETER_DESC paramDesc;
+    rc = RfcGetParameterDescByName(
+        functionDescHandle, cName, &paramDesc, errorInfo);
+  } else {
+    RFC_FIELD_DESC fieldDesc;
+    rc = RfcGetFieldDescByName(typeDescHandle, cName, &fieldDesc, errorInfo);
+  }
+  delete[] cName;
+  if (rc == RFC_OK) {
+    // SDK found what the plan did not, for example by a name alias
+    errorInfo->code = RFC_INVALID_PARAMETER;
+    errorInfo->group = EXTERNAL_RUNTIME_FAILURE;
+    SAP_UC* message = setString("field '" + name + "' not found");
+    strncpyU(errorInfo->message, message, strlenU(message) + 1);
+    delete[] message;
+  }
+  return nullptr;
+}
+
+BindingPlanPtr Metadata::getParameterPlan(
+    RFC_FUNCTION_DESC_HANDLE functionDescHandle, RFC_ERROR_INFO* errorInfo) {
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = parameterPlans.find(functionDescHandle);
+    if (it != parameterPlans.end()) {
+      return it->second;
+    }
+  }
+
+  uint_t paramCount;
+  RFC_RC rc =
+      RfcGetParameterCount(functionDescHandle, &paramCount, errorInfo);
+  if (rc != RFC_OK) {
+    return nullptr;
+  }
+
+  std::shared_ptr<BindingPlan> plan = std::make_shared<BindingPlan>();
+  plan->functionDescHandle = functionDescHandle;
+  plan->fields.resize(paramCount);
+  for (uint_t i = 0; i < paramCount; i++) {
+    RFC_PARAMETER_DESC paramDesc;
+    rc = RfcGetParameterDescByIndex(
+        functionDescHandle, i, &paramDesc, errorInfo);
+    if (rc != RFC_OK) {
+      return nullptr;
+    }
+    FieldBinding* binding = &plan->fields[i];
+    binding->index = i;
+    binding->type = paramDesc.type;
+    strcpyU(binding->name, paramDesc.name);
+    binding->direction = paramDesc.direction;
+    binding->nucLength = paramDesc.nucLength;
+    binding->ucLength = paramDesc.ucLength;
+    binding->nucOffset = 0;
+    binding->ucOffset = 0;
+    binding->decimals = paramDesc.decimals;
+    binding->typeDescHandle = paramDesc.typeDescHandle;
+    plan->names[ucToUtf8(paramDesc.name)] = i;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return parameterPlans.emplace(functionDescHandle, plan).first->second;
+}
+
+BindingPlanPtr Metadata::getTypePlan(RFC_TYPE_DESC_HANDLE typeDescHandle,
+                                     RFC_ERROR_INFO* errorInfo) {
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = typePlans.find(typeDescHandle);
+    if (it != typePlans.end()) {
+      return it->second;
+    }
+  }
+
+  uint_t fieldCount;
+  RFC_RC rc = RfcGetFieldCount(typeDescHandle, &fieldCount, errorInfo);
+  if (rc != RFC_OK) {
+    return nullptr;
+  }
+
+  std::shared_ptr<BindingPlan> plan = std::make_shared<BindingPlan>();
+  plan->typeDescHandle = typeDescHandle;
+  uint_t nucLength;
+  rc = RfcGetTypeLength(
+      typeDescHandle, &nucLength, &plan->ucLength, errorInfo);
+  if (rc != RFC_OK) {
+    return nullptr;
+  }
+  plan->flat = fieldCount > 0;
+  plan->charLike = fieldCount > 0;
+  plan->fields.resize(fieldCount);
+  for (uint_t i = 0; i < fieldCount; i++) {
+    RFC_FIELD_DESC fieldDesc;
+    rc = RfcGetFieldDescByIndex(typeDescHandle, i, &fieldDesc, errorInfo);
+    if (rc != RFC_OK) {
+      return nullptr;
+    }
+    FieldBinding* binding = &plan->fields[i];
+    binding->index = i;
+    binding->type = fieldDesc.type;
+    strcpyU(binding->name, fieldDesc.name);
+    binding->direction = (RFC_DIRECTION)0;
+    binding->nucLength = fieldDesc.nucLength;
+    binding->ucLength = fieldDesc.ucLength;
+    binding->nucOffset = fieldDesc.nucOffset;
+    binding->ucOffset = fieldDesc.ucOffset;
+    binding->decimals = fieldDesc.decimals;
+    binding->typeDescHandle = fieldDesc.typeDescHandle;
+    plan->names[ucToUtf8(fieldDesc.name)] = i;
+
+    switch (fieldDesc.type) {
+      case RFCTYPE_CHAR:
+      case RFCTYPE_NUM:
+      case RFCTYPE_DATE:
+      case RFCTYPE_TIME:
+        break;
+      case RFCTYPE_BYTE:
+      case RFCTYPE_INT:
+      case RFCTYPE_INT1:
+      case RFCTYPE_INT2:
+      case RFCTYPE_FLOAT:
+        plan->charLike = false;
+        break;
+      default:
+        plan->flat = false;
+        plan->charLike = false;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return typePlans.emplace(typeDescHandle, plan).first->second;
+}
+
+FunctionDescPtr Metadata::newFunctionDesc(RFC_FUNCTION_DESC_HANDLE handle,
+                                          const FunctionDescKey& key) {
+  // Cache mutex locked by the caller
+  DescHandle& descHandle = descHandles[handle];
+  descHandle.holders++;
+  descHandle.sysId = std::get<0>(key);
+  FunctionDesc* functionDesc = new FunctionDesc();
+  functionDesc->handle = handle;
+  functionDesc->key = key;
+  return FunctionDescPtr(functionDesc, [this](FunctionDesc* functionDesc) {
+    releaseFunctionDesc(functionDesc);
+  });
+}
+
+void Metadata::releaseFunctionDesc(FunctionDesc* functionDesc) {
+  {
+    // Invalidated and the last cache entry or call holding the SDK
+    // descriptor done, removed from SDK
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = descHandles.find(functionDesc->handle);
+    if (it != descHandles.end() && --it->second.holders == 0) {
+      bool retired = it->second.retired;
+      descHandles.erase(it);
+      if (retired) {
+        parameterPlans.erase(functionDesc->handle);
+        RFC_SID repositoryID;
+        RFC_ABAP_NAME funcName;
+        RFC_ERROR_INFO errorInfo;
+        ucFromKey(std::get<0>(functionDesc->key), repositoryID);
+        ucFromKey(std::get<2>(functionDesc->key), funcName);
+        RFC_RC rc = RfcRemoveFunctionDesc(repositoryID, funcName, &errorInfo);
+        removals++;
+        if (rc != RFC_OK && rc != RFC_NOT_FOUND) {
+          _log.warning(logClass::addon,
+                       "Function descriptor not removed from SDK repository: ",
+                       rc);
+        }
+      }
+    }
+  }
+  delete functionDesc;
+}
+
+FunctionDescPtr Metadata::getFunctionDesc(
+    RFC_CONNECTION_HANDLE connectionHandle,
+    const SAP_UC* funcName,
+    RFC_ERROR_INFO* errorInfo,
+    FunctionDescKey* cacheKey) {
+  RFC_ATTRIBUTES attributes;
+  RFC_RC rc =
+      RfcGetConnectionAttributes(connectionHandle, &attributes, errorInfo);
+  if (rc != RFC_OK) {
+    return nullptr;
+  }
+
+  FunctionDescKey key = FunctionDescKey(
+      ucKey(attributes.sysId), ucKey(attributes.client), ucKey(funcName));
+  if (cacheKey != nullptr) {
+    *cacheKey = key;
+  }
+
+  uint64_t removalsRead;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = functionDescs.find(key);
+    if (it != functionDescs.end()) {
+      hits++;
+      return it->second;
+    }
+    misses++;
+    removalsRead = removals;
+  }
+
+  // Not cached, read from ABAP system or SDK repository
+  while (true) {
+    RFC_FUNCTION_DESC_HANDLE handle =
+        RfcGetFunctionDesc(connectionHandle, funcName, errorInfo);
+    if (handle == nullptr || errorInfo->code != RFC_OK) {
+      return nullptr;
+    }
+
+    FunctionDescPtr functionDesc;
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      if (removals != removalsRead) {
+        // the handle could be removed from SDK meanwhile, read again
+        removalsRead = removals;
+        continue;
+      }
+      auto it = descHandles.find(handle);
+      if (it != descHandles.end() && it->second.retired) {
+        // Invalidated but still used by other calls, therefore not yet
+        // removed from SDK. Shared with this call, not cached.
+        for (auto const& retiredDesc : it->second.retiredDescs) {
+          functionDesc = retiredDesc.lock();
+          if (functionDesc != nullptr) {
+            return functionDesc;
+          }
+        }
+        // being removed from SDK, read again when done
+        continue;
+      }
+      auto cached = functionDescs.find(key);
+      if (cached != functionDescs.end()) {
+        return cached->second;
+      }
+      // New, or held by cache entries of other clients of the system
+      functionDesc = newFunctionDesc(handle, key);
+      functionDescs[key] = functionDesc;
+    }
+
+    // Build the parameters plan here, in worker thread
+    RFC_ERROR_INFO planErrorInfo;
+    getParameterPlan(handle, &planErrorInfo);
+    return functionDesc;
+  }
+}
+
+FunctionDescPtr Metadata::findFunctionDesc(const FunctionDescKey& repository,
+                                           const SAP_UC* funcName) {
+  if (std::get<0>(repository).empty()) {
+    return nullptr;
+  }
+  FunctionDescKey key = FunctionDescKey(
+      std::get<0>(repository), std::get<1>(repository), ucKey(funcName));
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto it = functionDescs.find(key);
+  if (it == functionDescs.end()) {
+    return nullptr;
+  }
+  hits++;
+  return it->second;
+}
+
+uint_t Metadata::retire(const std::string* name,
+                        const SAP_UC* sysId,
+                        std::set<std::string>* repositories) {
+  std::vector<FunctionDescPtr> removed;
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto it = functionDescs.begin(); it != functionDescs.end();) {
+      if ((name == nullptr || std::get<2>(it->first) == *name) &&
+          (sysId == nullptr || std::get<0>(it->first) == ucKey(sysId))) {
+        repositories->insert(std::get<0>(it->first));
+        DescHandle& descHandle = descHandles[it->second->handle];
+        descHandle.retired = true;
+        descHandle.retiredDescs.push_back(it->second);
+        removed.push_back(it->second);
+        it = functionDescs.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  // Descriptors not used by calls are removed from SDK here, without
+  // the lock, the others when the last call holding them is done
+  uint_t count = removed.size();
+  removed.clear();
+  return count;
+}
+
+uint_t Metadata::invalidate(const SAP_UC* funcName, const SAP_UC* sysId) {
+  std::string name = ucKey(funcName);
+  std::set<std::string> repositories;
+  uint_t removed = retire(&name, sysId, &repositories);
+  _log.info(logClass::addon, "Function descriptors invalidated: ", removed);
+  return removed;
+}
+
+uint_t Metadata::clear(const SAP_UC* sysId) {
+  std::set<std::string> repositories;
+  if (sysId != nullptr) {
+    repositories.insert(ucKey(sysId));
+  }
+  uint_t removed = retire(nullptr, sysId, &repositories);
+
+  // Type descriptors are removed with the SDK repository, only when no
+  // function descriptor of that repository is used by calls
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  for (auto const& repository : repositories) {
+    bool used = false;
+    for (auto const& entry : descHandles) {
+      used = used || entry.second.sysId == repository;
+    }
+    if (used) {
+      continue;
+    }
+    RFC_SID repositoryID;
+    RFC_ERROR_INFO errorInfo;
+    ucFromKey(repository, repositoryID);
+    RFC_RC rc = RfcClearRepository(repositoryID, &errorInfo);
+    removals++;
+    if (rc != RFC_OK && rc != RFC_NOT_FOUND) {
+      _log.warning(logClass::addon, "SDK repository not cleared: ", rc);
+    }
+  }
+  typePlans.clear();
+
+  _log.info(logClass::addon, "Function descriptors cache cleared: ", removed);
+  return removed;
+}
+
+Napi::Value Metadata::status(Napi::Env env) {
+  Napi::EscapableHandleScope scope(env);
+  Napi::Object status = Napi::Object::New(env);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  status.Set("size", Napi::Number::New(env, functionDescs.size()));
+  status.Set("hits", Napi::Number::New(env, static_cast<double>(hits)));
+  status.Set("misses", Napi::Number::New(env, static_cast<double>(misses)));
+
+  return scope.Escape(status);
+}
+
+Napi::Value InvalidateFunctionDescription(const Napi::CallbackInfo& info) {
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(
+        info.Env(),
+        "invalidateFunctionDescription() requires the RFM name string")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+  if (!info[1].IsUndefined() && !info[1].IsString()) {
+    Napi::TypeError::New(
+        info.Env(),
+        "invalidateFunctionDescription() system ID, if provided, must be a "
+        "string")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  SAP_UC* funcName = setString(info[0].As<Napi::String>());
+  SAP_UC* sysId =
+      info[1].IsString() ? setString(info[1].As<Napi::String>()) : nullptr;
+  uint_t removed = _metadata.invalidate(funcName, sysId);
+  delete[] funcName;
+  delete[] sysId;
+
+  return Napi::Number::New(info.Env(), removed);
+}
+
+Napi::Value ClearCache(const Napi::CallbackInfo& info) {
+  if (!info[0].IsUndefined() && !info[0].IsString()) {
+    Napi::TypeError::New(
+        info.Env(), "clearCache() system ID, if provided, must be a string")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  SAP_UC* sysId =
+      info[0].IsString() ? setString(info[0].As<Napi::String>()) : nullptr;
+  uint_t removed = _metadata.clear(sysId);
+  delete[] sysId;
+
+  return Napi::Number::New(info.Env(), removed);
+}
+
+Napi::Value CacheStatus(const Napi::CallbackInfo& info) {
+  return _metadata.status(info.Env());
+}
+
+Napi::Object Metadata::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("invalidateFunctionDescription",
+              Napi::Function::New(env, InvalidateFunctionDescription));
+  exports.Set("clearCache", Napi::Function::New(env, ClearCache));
+  exports.Set("cacheStatus", Napi::Function::New(env, CacheStatus));
+  return exports;
+}
+
+// Create function descriptors cache instance
+Metadata _metadata = Metadata();
+
+}  // namespace node_rfc
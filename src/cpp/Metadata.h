@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_Metadata_H
+#define NodeRfc_Metadata_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+//
+// Function descriptor cache key: ABAP system ID, client, RFM name.
+// SAP unicode strings are stored as raw bytes, no conversion needed.
+//
+typedef std::tuple<std::string, std::string, std::string> FunctionDescKey;
+
+//
+// Function descriptor held by node-rfc calls, from the descriptor read
+// until the call is done. Invalidated descriptors are removed from the
+// SDK repository after the last call holding them is done.
+//
+typedef struct _FunctionDesc {
+  RFC_FUNCTION_DESC_HANDLE handle;
+  FunctionDescKey key;
+} FunctionDesc;
+
+typedef std::shared_ptr<FunctionDesc> FunctionDescPtr;
+
+//
+// SDK function descriptor, one per ABAP system and RFM name, shared by the
+// cache entries of all clients of that system. Guarded by the cache mutex.
+//
+typedef struct _DescHandle {
+  uint_t holders = 0;    // FunctionDesc instances not yet released
+  bool retired = false;  // removed from SDK when no more holders
+  std::string sysId;
+  // Invalidated instances still held by calls, shared by new calls
+  std::vector<std::weak_ptr<FunctionDesc>> retiredDescs;
+} DescHandle;
+
+//
+// Function descriptors cache, shared by all Client and Pool instances
+//
+class Metadata {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // Returns the cached function descriptor or reads it from the ABAP system.
+  // Worker thread, the caller must hold the client invocation mutex.
+  // The cache key is returned in cacheKey, if provided.
+  FunctionDescPtr getFunctionDesc(RFC_CONNECTION_HANDLE connectionHandle,
+                                  const SAP_UC* funcName,
+                                  RFC_ERROR_INFO* errorInfo,
+                                  FunctionDescKey* cacheKey = nullptr);
+
+  // Returns the cached function descriptor of the ABAP system and client
+  // from the repository key, or nullptr. No SDK calls, main thread safe.
+  FunctionDescPtr findFunctionDesc(const FunctionDescKey& repository,
+                                   const SAP_UC* funcName);
+
+  // Returns the binding plan, built at first request for the descriptor.
+  // Plans are immutable and can be used without locking.
+  BindingPlanPtr getParameterPlan(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
+                                  RFC_ERROR_INFO* errorInfo);
+  BindingPlanPtr getTypePlan(RFC_TYPE_DESC_HANDLE typeDescHandle,
+                             RFC_ERROR_INFO* errorInfo);
+
+  // Removes function descriptor(s) from node-rfc cache. Removed from SAP NW
+  // RFC SDK cache when no more used by node-rfc calls.
+  uint_t invalidate(const SAP_UC* funcName, const SAP_UC* sysId = nullptr);
+  uint_t clear(const SAP_UC* sysId = nullptr);
+
+  Napi::Value status(Napi::Env env);
+
+ private:
+  FunctionDescPtr newFunctionDesc(RFC_FUNCTION_DESC_HANDLE handle,
+                                  const FunctionDescKey& key);
+  void releaseFunctionDesc(FunctionDesc* functionDesc);
+  uint_t retire(const std::string* name,
+                const SAP_UC* sysId,
+                std::set<std::string>* repositories);
+
+  std::mutex cacheMutex;
+  std::map<FunctionDescKey, FunctionDescPtr> functionDescs;
+  // SDK descriptors held by cache entries and calls
+  std::unordered_map<RFC_FUNCTION_DESC_HANDLE, DescHandle> descHandles;
+  // Incremented by each SDK repository removal
+  uint64_t removals = 0;
+  std::unordered_map<RFC_FUNCTION_DESC_HANDLE, BindingPlanPtr> parameterPlans;
+  std::unordered_map<RFC_TYPE_DESC_HANDLE, BindingPlanPtr> typePlans;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+extern Metadata _metadata;
+
+}  // namespace node_rfc
+
+#endif
@@ -0,0 +1,651 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ParameterBuffer.h"
+
+#include <cmath>
+
+#include "Metadata.h"
+#include "Transcode.h"
+
+namespace node_rfc {
+
+////////////////////////////////////////////////////////////////////////////////
+// Snapshot (main thread)
+////////////////////////////////////////////////////////////////////////////////
+
+// NaN and Infinity have no ABAP representation
+Napi::Value nonFiniteError(RFCTYPE typ,
+                           Napi::Value value,
+                           RfmErrorPath* errorPath) {
+  return nodeRfcError(
+      "Finite number expected from NodeJS for ABAP field of type " +
+          std::to_string(typ) + ", got " + value.ToString().Utf8Value(),
+      errorPath);
+}
+
+Napi::Value ParameterBuffer::snapshot(
+    RFC_FUNCTION_DESC_HANDLE functionDescHandle,
+    Napi::Object params,
+    RfmErrorPath* errorPath,
+    ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(params.Env());
+
+  RFC_ERROR_INFO errorInfo;
+  this->errorPath = *errorPath;
+  parameterPlan = _metadata.getParameterPlan(functionDescHandle, &errorInfo);
+  if (parameterPlan == nullptr) {
+    return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+  }
+
+  Napi::Array paramNames = params.GetPropertyNames();
+  uint_t paramSize = paramNames.Length();
+
+  for (uint_t i = 0; i < paramSize; i++) {
+    Napi::String name = paramNames.Get(i).ToString();
+    const FieldBinding* binding =
+        parameterPlan->find(name.Utf8Value(), &errorInfo);
+    if (binding == nullptr) {
+      SAP_UC* cName = setString(name);
+      errorPath->setParameterName(cName);
+      delete[] cName;
+      return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+    }
+    errorPath->setParameterName(binding->name);
+    Napi::Value rv =
+        snapshotValue(binding, params.Get(name), errorPath, client_options);
+    if (!rv.IsUndefined()) {
+      return scope.Escape(rv);
+    }
+  }
+  return scope.Env().Undefined();
+}
+
+const BindingPlan* ParameterBuffer::getTypePlan(
+    RFC_TYPE_DESC_HANDLE typeDescHandle, RFC_ERROR_INFO* errorInfo) {
+  // Plans are kept until parameters are set
+  auto it = typePlans.find(typeDescHandle);
+  if (it != typePlans.end()) {
+    return it->second.get();
+  }
+  BindingPlanPtr plan = _metadata.getTypePlan(typeDescHandle, errorInfo);
+  if (plan == nullptr) {
+    return nullptr;
+  }
+  typePlans.emplace(typeDescHandle, plan);
+  return plan.get();
+}
+
+void ParameterBuffer::appendData(const void* bytes,
+                                 size_t length,
+                                 ParameterValue* value) {
+  value->offset = data.size();
+  value->length = length;
+  data.append(static_cast<const char*>(bytes), length);
+}
+
+void ParameterBuffer::appendString(Napi::Value value, ParameterValue* entry) {
+  // UTF-8 bytes copied into data, without intermediate string
+  size_t length = 0;
+  napi_get_value_string_utf8(value.Env(), value, nullptr, 0, &length);
+  entry->offset = data.size();
+  data.resize(entry->offset + length + 1);
+  napi_get_value_string_utf8(
+      value.Env(), value, &data[entry->offset], length + 1, &length);
+  data.resize(entry->offset + length);
+  entry->length = length;
+}
+
+Napi::Value ParameterBuffer::snapshotStructure(
+    const BindingPlan* typePlan,
+    size_t structIndex,
+    Napi::Value value,
+    RfmErrorPath* errorPath,
+    ClientOptionsStruct* client_options) {
+  RFC_ERROR_INFO errorInfo;
+
+  Napi::EscapableHandleScope scope(value.Env());
+
+  Napi::Object structObj = value.ToObject();
+  Napi::Array structNames = structObj.GetPropertyNames();
+  uint_t structSize = structNames.Length();
+
+  for (uint_t i = 0; i < structSize; i++) {
+    Napi::String name = structNames.Get(i).ToString();
+
+    const FieldBinding* binding = typePlan->find(name.Utf8Value(), &errorInfo);
+    if (binding == nullptr) {
+      SAP_UC* cName = setString(name);
+      errorPath->setFieldName(cName);
+      delete[] cName;
+      return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+    }
+    Napi::Value rv = snapshotValue(
+        binding, structObj.Get(name), errorPath, client_options);
+    if (!rv.IsUndefined()) {
+      return scope.Escape(rv);
+    }
+    values[structIndex].length++;
+  }
+  return scope.Env().Undefined();
+}
+
+Napi::Value ParameterBuffer::snapshotValue(
+    const FieldBinding* binding,
+    Napi::Value value,
+    RfmErrorPath* errorPath,
+    ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(value.Env());
+  RFC_ERROR_INFO errorInfo;
+  RFCTYPE typ = binding->type;
+
+  ParameterValue entry;
+  entry.binding = binding;
+  entry.length = 0;
+  entry.number = false;
+  entry.intValue = 0;
+
+  errorPath->setName(typ, binding->name);
+
+  switch (typ) {
+    case RFCTYPE_STRUCTURE: {
+      const BindingPlan* typePlan =
+          getTypePlan(binding->typeDescHandle, &errorInfo);
+      if (typePlan == nullptr) {
+        return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+      }
+      size_t structIndex = values.size();
+      values.push_back(entry);
+      return scope.Escape(snapshotStructure(
+          typePlan, structIndex, value, errorPath, client_options));
+    }
+    case RFCTYPE_TABLE: {
+      if (!value.IsArray() && !value.IsObject()) {
+        return nodeRfcError(
+            "Array or object of columns expected from NodeJS, for ABAP RFM "
+            "table of type " +
+                std::to_string(typ),
+            errorPath);
+      }
+      const BindingPlan* typePlan =
+          getTypePlan(binding->typeDescHandle, &errorInfo);
+      if (typePlan == nullptr) {
+        return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+      }
+      if (!value.IsArray()) {
+        values.push_back(entry);
+        return scope.Escape(snapshotColumns(typePlan,
+                                            values.size() - 1,
+                                            value.As<Napi::Object>(),
+                                            errorPath,
+                                            client_options));
+      }
+      Napi::Array array = value.As<Napi::Array>();
+      entry.length = array.Length();
+      values.push_back(entry);
+      const FieldBinding* lineBinding = nullptr;
+
+      for (uint_t i = 0; i < entry.length; i++) {
+        errorPath->table_line = i;
+        ParameterValue row;
+        row.binding = nullptr;
+        row.length = 0;
+        row.intValue = 0;
+        size_t rowIndex = values.size();
+        values.push_back(row);
+
+        Napi::Value line = array.Get(i);
+        Napi::Value rv;
+        if (line.IsBuffer() || line.IsString() || line.IsNumber() ||
+            line.IsBigInt() || line.IsDate() || line.IsNull()) {
+          // elementary line type, one field with empty name
+          if (lineBinding == nullptr) {
+            lineBinding = typePlan->find("", &errorInfo);
+          }
+          if (lineBinding == nullptr) {
+            return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+          }
+          rv = snapshotValue(lineBinding, line, errorPath, client_options);
+          values[rowIndex].length = 1;
+        } else {
+          rv = snapshotStructure(
+              typePlan, rowIndex, line, errorPath, client_options);
+        }
+        if (!rv.IsUndefined()) {
+          return scope.Escape(rv);
+        }
+      }
+      return scope.Env().Undefined();
+    }
+    case RFCTYPE_BYTE:
+    case RFCTYPE_XSTRING: {
+      if (!value.IsBuffer()) {
+        return nodeRfcError(
+            "Buffer expected from NodeJS for ABAP field of type " +
+                std::to_string(typ),
+            errorPath);
+      }
+      // excessive BYTE padding bytes sent from NodeJS, are silently trimmed
+      // by SDK to ABAP field length
+      Napi::Buffer<SAP_RAW> js_buf = value.As<Napi::Buffer<SAP_RAW>>();
+      appendData(js_buf.Data(), js_buf.ByteLength(), &entry);
+      break;
+    }
+    case RFCTYPE_CHAR:
+    case RFCTYPE_STRING: {
+      if (!value.IsString()) {
+        return nodeRfcError(
+            "String expected from NodeJS for ABAP field of type " +
+                std::to_string(typ),
+            errorPath);
+      }
+      appendString(value, &entry);
+      break;
+    }
+    case RFCTYPE_NUM: {
+      if (!value.IsString()) {
+        return nodeRfcError(
+            "Char expected from NodeJS for ABAP field of type " +
+                std::to_string(typ),
+            errorPath);
+      }
+      appendString(value, &entry);
+      break;
+    }
+    case RFCTYPE_BCD:  // fallthrough
+    case RFCTYPE_DECF16:
+    case RFCTYPE_DECF34:
+    case RFCTYPE_FLOAT: {
+      if (!value.IsNumber() && !value.IsObject() && !value.IsString() &&
+          !(value.IsBigInt() && typ != RFCTYPE_FLOAT)) {
+        return nodeRfcError("Number, number object or string expected from "
+                            "NodeJS for ABAP field of type " +
+                                std::to_string(typ),
+                            errorPath);
+      }
+      if (value.IsBigInt()) {
+        int scale = client_options->bcd == CLIENT_OPTION_BCD_SCALED_BIGINT
+                        ? client_options->decimalScale(binding->decimals)
+                        : 0;
+        std::string digits =
+            unwrapScaledDecimal(value.As<Napi::BigInt>(), scale);
+        appendData(digits.data(), digits.length(), &entry);
+        break;
+      }
+      if (value.IsNumber()) {
+        // Formatted in worker thread, see fill()
+        entry.floatValue = value.As<Napi::Number>().DoubleValue();
+        if (!std::isfinite(entry.floatValue)) {
+          return scope.Escape(nonFiniteError(typ, value, errorPath));
+        }
+        entry.number = true;
+        break;
+      }
+      appendString(value.ToString(), &entry);
+      break;
+    }
+    case RFCTYPE_INT:  // fallthrough
+    case RFCTYPE_INT1:
+    case RFCTYPE_INT2:
+    case RFCTYPE_INT8: {
+      Napi::Value rv = toInteger(typ, value, &entry.intValue, errorPath);
+      if (!rv.IsUndefined()) {
+        return scope.Escape(rv);
+      }
+      break;
+    }
+    case RFCTYPE_UTCLONG: {
+      if (!value.IsString()) {
+        return nodeRfcError(
+            "UTCLONG string expected from NodeJS for ABAP field of type " +
+                std::to_string(typ),
+            errorPath);
+      }
+      appendString(value, &entry);
+      break;
+    }
+    case RFCTYPE_DATE: {
+      if (client_options->datePreset != CLIENT_OPTION_DATETIME_STRING) {
+        char date[8];
+        if (!unwrapDate(value, client_options->datePreset, date)) {
+          return nodeRfcError(
+              std::string("Date as ") +
+                  dateTimePresetName(client_options->datePreset) +
+                  " expected from NodeJS for ABAP field of type " +
+                  std::to_string(typ),
+              errorPath);
+        }
+        appendData(date, 8, &entry);
+        break;
+      }
+      if (!client_options->dateToABAP.IsEmpty()) {
+        // YYYYMMDD format expected
+        value = client_options->dateToABAP.Call({value});
+      }
+      if (!value.IsString()) {
+        return nodeRfcError("Date format YYYYMMDD expected from NodeJS "
+                            "for ABAP field of type " +
+                                std::to_string(typ),
+                            errorPath);
+      }
+      appendString(value, &entry);
+      break;
+    }
+    case RFCTYPE_TIME: {
+      if (client_options->timePreset != CLIENT_OPTION_DATETIME_STRING) {
+        char time[6];
+        if (!unwrapTime(value, client_options->timePreset, time)) {
+          return nodeRfcError(
+              std::string("Time as ") +
+                  dateTimePresetName(client_options->timePreset) +
+                  " expected from NodeJS for ABAP field of type " +
+                  std::to_string(typ),
+              errorPath);
+        }
+        appendData(time, 6, &entry);
+        break;
+      }
+      if (!client_options->timeToABAP.IsEmpty()) {
+        // HHMMSS format expected
+        value = client_options->timeToABAP.Call({value});
+      }
+      if (!value.IsString()) {
+        return nodeRfcError("Time format HHMMSS expected from NodeJS for "
+                            "ABAP field of type " +
+                                std::to_string(typ),
+                            errorPath);
+      }
+      appendString(value, &entry);
+      break;
+    }
+    default: {
+      return nodeRfcError("Unknown RFC type from NodeJS " + std::to_string(typ),
+                          errorPath);
+    }
+  }
+
+  values.push_back(entry);
+  return scope.Env().Undefined();
+}
+
+Napi::Value ParameterBuffer::snapshotInteger(const FieldBinding* binding,
+                                             double number,
+                                             RfmErrorPath* errorPath,
+                                             ParameterValue* entry) {
+  if (number >= -9223372036854775808.0 && number < 9223372036854775808.0 &&
+      (int64_t)number == number &&
+      integerInRange(binding->type, (int64_t)number)) {
+    entry->intValue = (int64_t)number;
+    return node_rfc::__env.Undefined();
+  }
+  // Same error as for Number value
+  errorPath->setName(binding->type, binding->name);
+  return toInteger(binding->type,
+                   Napi::Number::New(node_rfc::__env, number),
+                   &entry->intValue,
+                   errorPath);
+}
+
+Napi::Value ParameterBuffer::snapshotColumns(
+    const BindingPlan* typePlan,
+    size_t tableIndex,
+    Napi::Object value,
+    RfmErrorPath* errorPath,
+    ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(value.Env());
+
+  ImportColumns columns;
+  Napi::Value rv = columns.init(typePlan, value, errorPath);
+  if (!rv.IsUndefined()) {
+    return scope.Escape(rv);
+  }
+  uint_t columnCount = columns.columns.size();
+  values[tableIndex].length = columns.rowCount;
+  values.reserve(values.size() + columns.rowCount * (columnCount + 1));
+
+  for (uint_t i = 0; i < columns.rowCount; i++) {
+    Napi::HandleScope rowScope(value.Env());
+    errorPath->table_line = i;
+    ParameterValue row;
+    row.binding = nullptr;
+    row.length = columnCount;
+    row.intValue = 0;
+    values.push_back(row);
+
+    for (const ImportColumn& column : columns.columns) {
+      ParameterValue entry;
+      entry.binding = column.binding;
+      entry.length = 0;
+      entry.number = false;
+      entry.intValue = 0;
+
+      // Typed array and Buffer values read from memory
+      if (column.width > 0) {
+        appendData(column.data + i * column.width, column.width, &entry);
+        values.push_back(entry);
+        continue;
+      }
+      if (column.type == napi_bigint64_array &&
+          column.binding->type == RFCTYPE_INT8) {
+        entry.intValue = reinterpret_cast<const int64_t*>(column.data)[i];
+        values.push_back(entry);
+        continue;
+      }
+      if (column.data != nullptr && column.type != napi_bigint64_array &&
+          column.type != napi_biguint64_array) {
+        double number = ImportColumns::number(column, i);
+        switch (column.binding->type) {
+          case RFCTYPE_FLOAT:
+            if (!std::isfinite(number)) {
+              errorPath->setName(RFCTYPE_FLOAT, column.binding->name);
+              return scope.Escape(nonFiniteError(
+                  RFCTYPE_FLOAT,
+                  Napi::Number::New(value.Env(), number),
+                  errorPath));
+            }
+            entry.number = true;
+            entry.floatValue = number;
+            values.push_back(entry);
+            continue;
+          case RFCTYPE_INT:  // fallthrough
+          case RFCTYPE_INT1:
+          case RFCTYPE_INT2:
+          case RFCTYPE_INT8:
+            rv = snapshotInteger(column.binding, number, errorPath, &entry);
+            if (!rv.IsUndefined()) {
+              return scope.Escape(rv);
+            }
+            values.push_back(entry);
+            continue;
+          default:
+            break;
+        }
+      }
+
+      rv = snapshotValue(
+          column.binding, columns.get(column, i), errorPath, client_options);
+      if (!rv.IsUndefined()) {
+        return scope.Escape(rv);
+      }
+    }
+  }
+  return scope.Env().Undefined();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Fill (worker thread)
+////////////////////////////////////////////////////////////////////////////////
+
+bool ParameterBuffer::fill(RFC_FUNCTION_HANDLE functionHandle) {
+  errorInfo.code = RFC_OK;
+  next = 0;
+  while (next < values.size()) {
+    errorPath.setParameterName(values[next].binding->name);
+    if (!fillValue(functionHandle)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParameterBuffer::toSAPUC(const ParameterValue& value, uint_t* ucLength) {
+  // DATE and TIME setters read fixed length, zero padded
+  uint_t ucSize = value.length + 1;
+  ucBuffer.assign(ucSize < 9 ? 9 : ucSize, 0);
+  *ucLength = 0;
+  const RFC_BYTE* utf8 =
+      reinterpret_cast<const RFC_BYTE*>(data.data()) + value.offset;
+  if (transcodeToSAPUC(utf8, value.length, ucBuffer.data(), ucLength)) {
+    return true;
+  }
+  RFC_RC rc = RfcUTF8ToSAPUC(
+      utf8, value.length, ucBuffer.data(), &ucSize, ucLength, &errorInfo);
+  return rc == RFC_OK;
+}
+
+bool ParameterBuffer::fillValue(DATA_CONTAINER_HANDLE container) {
+  RFC_RC rc = RFC_OK;
+  const ParameterValue value = values[next++];
+  const FieldBinding* binding = value.binding;
+  uint_t index = binding->index;
+  uint_t ucLength;
+
+  switch (binding->type) {
+    case RFCTYPE_STRUCTURE: {
+      RFC_STRUCTURE_HANDLE structHandle;
+      rc = RfcGetStructureByIndex(container, index, &structHandle, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      errorPath.setName(RFCTYPE_STRUCTURE, binding->name);
+      for (uint_t i = 0; i < value.length; i++) {
+        if (!fillValue(structHandle)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case RFCTYPE_TABLE: {
+      RFC_TABLE_HANDLE tableHandle;
+      rc = RfcGetTableByIndex(container, index, &tableHandle, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      // Table rows are not consumed when read, replace them
+      rc = RfcDeleteAllRows(tableHandle, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      errorPath.setName(RFCTYPE_TABLE, binding->name);
+      // All rows appended at once, then filled in place as current row
+      if (value.length > 0) {
+        rc = RfcAppendNewRows(tableHandle, value.length, &errorInfo);
+        if (rc == RFC_OK) {
+          rc = RfcMoveToFirstRow(tableHandle, &errorInfo);
+        }
+        if (rc != RFC_OK) {
+          break;
+        }
+      }
+      for (uint_t i = 0; i < value.length; i++) {
+        errorPath.table_line = i;
+        if (i > 0 && RfcMoveToNextRow(tableHandle, &errorInfo) != RFC_OK) {
+          return false;
+        }
+        const ParameterValue row = values[next++];
+        for (uint_t f = 0; f < row.length; f++) {
+          if (!fillValue(tableHandle)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+    case RFCTYPE_BYTE:
+      rc = RfcSetBytesByIndex(
+          container,
+          index,
+          reinterpret_cast<const SAP_RAW*>(data.data()) + value.offset,
+          value.length,
+          &errorInfo);
+      break;
+    case RFCTYPE_XSTRING:
+      rc = RfcSetXStringByIndex(
+          container,
+          index,
+          reinterpret_cast<const SAP_RAW*>(data.data()) + value.offset,
+          value.length,
+          &errorInfo);
+      break;
+    case RFCTYPE_NUM:
+      if (!toSAPUC(value, &ucLength)) {
+        rc = errorInfo.code;
+        break;
+      }
+      rc = RfcSetNumByIndex(
+          container, index, ucBuffer.data(), ucLength, &errorInfo);
+      break;
+    case RFCTYPE_DATE:
+      if (!toSAPUC(value, &ucLength)) {
+        rc = errorInfo.code;
+        break;
+      }
+      rc = RfcSetDateByIndex(container, index, ucBuffer.data(), &errorInfo);
+      break;
+    case RFCTYPE_TIME:
+      if (!toSAPUC(value, &ucLength)) {
+        rc = errorInfo.code;
+        break;
+      }
+      rc = RfcSetTimeByIndex(container, index, ucBuffer.data(), &errorInfo);
+      break;
+    case RFCTYPE_INT8:
+      rc = RfcSetInt8ByIndex(container, index, value.intValue, &errorInfo);
+      break;
+    case RFCTYPE_INT:
+    case RFCTYPE_INT1:
+    case RFCTYPE_INT2:
+      rc = RfcSetIntByIndex(
+          container, index, (RFC_INT)value.intValue, &errorInfo);
+      break;
+    case RFCTYPE_FLOAT:
+      if (value.number) {
+        rc = RfcSetFloatByIndex(
+            container, index, value.floatValue, &errorInfo);
+        break;
+      }
+      // fallthrough
+    case RFCTYPE_BCD:
+    case RFCTYPE_DECF16:
+    case RFCTYPE_DECF34:
+      if (value.number) {
+        ucBuffer.resize(32);
+        formatDecimal(value.floatValue, ucBuffer.data(), &ucLength);
+        rc = RfcSetStringByIndex(
+            container, index, ucBuffer.data(), ucLength, &errorInfo);
+        break;
+      }
+      // fallthrough
+    default:
+      // CHAR, STRING, BCD, DECF16, DECF34, FLOAT, UTCLONG
+      if (!toSAPUC(value, &ucLength)) {
+        rc = errorInfo.code;
+        break;
+      }
+      rc = RfcSetStringByIndex(
+          container, index, ucBuffer.data(), ucLength, &errorInfo);
+  }
+
+  if (rc != RFC_OK) {
+    errorPath.setName(binding->type, binding->name);
+    return false;
+  }
+  return true;
+}
+
+Napi::Value ParameterBuffer::error() {
+  return rfcSdkError(&errorInfo, &errorPath);
+}
+
+}  // namespace node_rfc
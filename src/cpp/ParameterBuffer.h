@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_ParameterBuffer_H
+#define NodeRfc_ParameterBuffer_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+//
+// NodeJS parameter value snapshot. Strings and bytes are stored in the
+// buffer data. Structure values are followed by their field values, table
+// values by their rows. Table row value has no binding and is followed by
+// the row field values.
+//
+typedef struct _ParameterValue {
+  const FieldBinding* binding;
+  uint_t length;  // data bytes, structure fields or table rows
+  bool number;    // FLOAT or decimal in floatValue, string in data otherwise
+  union {
+    int64_t intValue;
+    double floatValue;
+    size_t offset;
+  };
+} ParameterValue;
+
+//
+// RFM call parameters, snapshot of NodeJS values taken in main thread and
+// set in worker thread.
+//
+class ParameterBuffer {
+ public:
+  // Main thread, returns the error or undefined
+  Napi::Value snapshot(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
+                       Napi::Object params,
+                       RfmErrorPath* errorPath,
+                       ClientOptionsStruct* client_options);
+
+  // Worker thread, no NodeJS API used
+  bool fill(RFC_FUNCTION_HANDLE functionHandle);
+
+  // Main thread, fill() error
+  Napi::Value error();
+
+ private:
+  Napi::Value snapshotStructure(const BindingPlan* typePlan,
+                                size_t structIndex,
+                                Napi::Value value,
+                                RfmErrorPath* errorPath,
+                                ClientOptionsStruct* client_options);
+  Napi::Value snapshotColumns(const BindingPlan* typePlan,
+                              size_t tableIndex,
+                              Napi::Object value,
+                              RfmErrorPath* errorPath,
+                              ClientOptionsStruct* client_options);
+  Napi::Value snapshotValue(const FieldBinding* binding,
+                            Napi::Value value,
+                            RfmErrorPath* errorPath,
+                            ClientOptionsStruct* client_options);
+  Napi::Value snapshotInteger(const FieldBinding* binding,
+                              double number,
+                              RfmErrorPath* errorPath,
+                              ParameterValue* entry);
+  const BindingPlan* getTypePlan(RFC_TYPE_DESC_HANDLE typeDescHandle,
+                                 RFC_ERROR_INFO* errorInfo);
+  void appendData(const void* bytes, size_t length, ParameterValue* value);
+  void appendString(Napi::Value value, ParameterValue* entry);
+
+  bool fillValue(DATA_CONTAINER_HANDLE container);
+  bool toSAPUC(const ParameterValue& value, uint_t* ucLength);
+
+  BindingPlanPtr parameterPlan;
+  std::unordered_map<RFC_TYPE_DESC_HANDLE, BindingPlanPtr> typePlans;
+
+  std::vector<ParameterValue> values;
+  std::string data;
+  std::vector<SAP_UC> ucBuffer;
+  size_t next = 0;
+
+  RFC_ERROR_INFO errorInfo;
+  RfmErrorPath errorPath;
+};
+
+}  // namespace node_rfc
+
+#endif
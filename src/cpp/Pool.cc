@@ -3,16 +3,22 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Batch.h"
+#include "Metadata.h"
 #include "Throughput.h"
 
 namespace node_rfc {
 uint_t Pool::_id = 1;
 std::mutex leaseMutex;
 
-class CheckPoolAsync : public Napi::AsyncWorker {
+class CheckPoolAsync : public RfcWorker {
  public:
   CheckPoolAsync(Napi::Function& callback, Pool* pool)
-      : Napi::AsyncWorker(callback), pool(pool) {}
+      : RfcWorker(callback), pool(pool) {}
   ~CheckPoolAsync() {}
 
   void Execute() {
@@ -43,10 +49,10 @@ class CheckPoolAsync : public Napi::AsyncWorker {
   Pool* pool;
 };
 
-class SetPoolAsync : public Napi::AsyncWorker {
+class SetPoolAsync : public RfcWorker {
  public:
   SetPoolAsync(Napi::Function& callback, Pool* pool, int32_t ready_low)
-      : Napi::AsyncWorker(callback), pool(pool), ready_low(ready_low) {}
+      : RfcWorker(callback), pool(pool), ready_low(ready_low) {}
   ~SetPoolAsync() {}
 
   void Execute() {
@@ -86,12 +92,12 @@ class SetPoolAsync : public Napi::AsyncWorker {
   uint_t ready_low;
 };
 
-class AcquireAsync : public Napi::AsyncWorker {
+class AcquireAsync : public RfcWorker {
  public:
   AcquireAsync(Napi::Function& callback,
                const uint_t clients_requested,
                Pool* pool)
-      : Napi::AsyncWorker(callback),
+      : RfcWorker(callback),
         clients_requested(clients_requested),
         pool(pool) {}
   ~AcquireAsync() {}
@@ -188,12 +194,12 @@ class AcquireAsync : public Napi::AsyncWorker {
   RFC_ERROR_INFO errorInfo;
 };
 
-class ReleaseAsync : public Napi::AsyncWorker {
+class ReleaseAsync : public RfcWorker {
  public:
   ReleaseAsync(Napi::Function& callback,
                Pool* pool,
                const std::set<Client*>& clients)
-      : Napi::AsyncWorker(callback), pool(pool), clients(clients) {}
+      : RfcWorker(callback), pool(pool), clients(clients) {}
   ~ReleaseAsync() {}
 
   void Execute() {
@@ -259,6 +265,294 @@ class ReleaseAsync : public Napi::AsyncWorker {
   uint_t closed_client_id = 0;
 };
 
+//
+// Pool invokeParallel() calls, shared by connection lanes
+//
+typedef struct _ParallelBatch {
+  BatchCalls calls;
+  std::atomic<size_t> next{0};  // next call to be taken by a lane
+  size_t lanes = 0;             // main thread, lanes running
+  Napi::Reference<Napi::Array> results;
+} ParallelBatch;
+
+typedef std::shared_ptr<ParallelBatch> ParallelBatchPtr;
+
+//
+// One leased connection, executing batch calls until all taken,
+// released back to the pool at the end. Lanes queued without connection
+// lease one first.
+//
+class ParallelLaneAsync : public RfcWorker {
+ public:
+  ParallelLaneAsync(Napi::Function& callback,
+                    Pool* pool,
+                    ParallelBatchPtr batch,
+                    RFC_CONNECTION_HANDLE connectionHandle)
+      : RfcWorker(callback),
+        pool(pool),
+        batch(batch),
+        connectionHandle(connectionHandle),
+        filter(pool->client_options.filter_param_type),
+        bcd(pool->client_options.bcd),
+        bcdScale(pool->client_options.bcdScale) {}
+  ~ParallelLaneAsync() {}
+
+  void Execute() {
+    if (connectionHandle == nullptr && batch->next < batch->calls.size()) {
+      RFC_ERROR_INFO errorInfo;
+      connectionHandle = pool->leaseConnection(&errorInfo);
+    }
+    size_t i;
+    while (connectionHandle != nullptr &&
+           (i = batch->next++) < batch->calls.size()) {
+      executed = true;
+      BatchCall& call = batch->calls[i];
+      if (!invokeBatchCall(&call, connectionHandle, filter, bcd, bcdScale) &&
+          call.errorInfo.code != RFC_OK) {
+        replaceBroken();
+      }
+    }
+    release();
+  }
+
+  void OnOK() {
+    if (--batch->lanes > 0) {
+      Callback().Reset();
+      return;
+    }
+
+    // last lane done, all calls wrapped
+    Napi::HandleScope scope(Env());
+    Napi::Array results = batch->results.Value();
+    size_t taken = std::min(batch->next.load(), batch->calls.size());
+    for (size_t i = 0; i < batch->calls.size(); i++) {
+      Napi::Value error = Env().Undefined();
+      if (i >= taken) {
+        error = nodeRfcError(
+            "Pool invokeParallel() call not executed, connections broken");
+      }
+      BatchCall& call = batch->calls[i];
+      results.Set(call.index,
+                  wrapBatchCall(&call, error, &pool->client_options));
+    }
+    batch->results.Reset();
+
+    Callback().Call({Env().Undefined(), results});
+    Callback().Reset();
+  }
+
+ private:
+  void replaceBroken() {
+    // SDK and ABAP errors keep the connection open
+    int isValid = 0;
+    RFC_ERROR_INFO errorInfo;
+    RfcIsConnectionHandleValid(connectionHandle, &isValid, &errorInfo);
+    if (isValid) {
+      return;
+    }
+    RFC_CONNECTION_HANDLE old_handle = connectionHandle;
+    RfcCloseConnection(old_handle, &errorInfo);
+    connectionHandle = RfcOpenConnection(pool->client_params.connectionParams,
+                                         pool->client_params.paramSize,
+                                         &errorInfo);
+    if (errorInfo.code != RFC_OK) {
+      connectionHandle = nullptr;
+      pool->lockMutex();
+      pool->connLeased.erase(old_handle);
+      pool->unlockMutex();
+      return;
+    }
+    pool->updateLeasedHandle(old_handle, connectionHandle);
+  }
+
+  void release() {
+    if (connectionHandle == nullptr) {
+      return;
+    }
+    // server context reset once per connection, not per call, and not
+    // when no call executed
+    RFC_ERROR_INFO errorInfo;
+    errorInfo.code = RFC_OK;
+    if (executed) {
+      RfcResetServerContext(connectionHandle, &errorInfo);
+    }
+    pool->lockMutex();
+    pool->connLeased.erase(connectionHandle);
+    bool ready = errorInfo.code == RFC_OK &&
+                 pool->connReady.size() < pool->ready_high;
+    if (ready) {
+      pool->connReady.insert(connectionHandle);
+    }
+    pool->unlockMutex();
+    if (!ready) {
+      RfcCloseConnection(connectionHandle, &errorInfo);
+    }
+  }
+
+  Pool* pool;
+  ParallelBatchPtr batch;
+  RFC_CONNECTION_HANDLE connectionHandle;
+  bool executed = false;
+  RFC_DIRECTION filter;
+  uint_t bcd;
+  int bcdScale;
+};
+
+class PrepareParallelAsync : public RfcWorker {
+ public:
+  PrepareParallelAsync(Napi::Function& callback,
+                       Pool* pool,
+                       Napi::Array& batch,
+                       uint_t concurrency)
+      : RfcWorker(callback),
+        pool(pool),
+        batch(Napi::Persistent(batch)),
+        concurrency(concurrency) {
+    for (uint_t i = 0; i < batch.Length(); i++) {
+      Napi::Object call = batch.Get(i).As<Napi::Object>();
+      funcNames.push_back(
+          setString(call.Get(BATCH_KEY_RFM).As<Napi::String>()));
+    }
+    functionDescs.resize(funcNames.size());
+    errorInfos.resize(funcNames.size());
+  }
+  ~PrepareParallelAsync() {
+    for (SAP_UC* funcName : funcNames) {
+      delete[] funcName;
+    }
+  }
+
+  void Execute() {
+    errorInfo.code = RFC_OK;
+    if (funcNames.empty()) {
+      return;
+    }
+
+    // One connection for reading descriptors, other lanes lease theirs
+    // when queued, for the calls prepared
+    connectionHandle = pool->leaseConnection(&errorInfo);
+
+    // function descriptors of all calls read at once
+    for (size_t i = 0; i < funcNames.size() && connectionHandle != nullptr;
+         i++) {
+      errorInfos[i].code = RFC_OK;
+      functionDescs[i] = _metadata.getFunctionDesc(
+          connectionHandle, funcNames[i], &errorInfos[i]);
+    }
+  }
+
+  void OnOK() {
+    Napi::HandleScope scope(Env());
+
+    if (connectionHandle == nullptr && !funcNames.empty()) {
+      Callback().Call({rfcSdkError(&errorInfo)});
+      Callback().Reset();
+      return;
+    }
+
+    Napi::Array results = Napi::Array::New(Env(), funcNames.size());
+    ParallelBatchPtr parallel(new ParallelBatch());
+    for (uint_t i = 0; i < funcNames.size(); i++) {
+      BatchCall call;
+      call.index = i;
+      call.functionDesc = functionDescs[i];
+      call.errorPath.setFunctionName(funcNames[i]);
+
+      Napi::Value error;
+      if (call.functionDesc == nullptr ||
+          errorInfos[i].code != RFC_OK) {
+        error = rfcSdkError(&errorInfos[i]);
+      } else {
+        error = prepareBatchCall(&call,
+                                 batch.Value().Get(i).As<Napi::Object>(),
+                                 &pool->client_options);
+      }
+
+      if (!error.IsUndefined()) {
+        results.Set(i, batchResult(error, Env().Undefined()));
+      } else {
+        parallel->calls.push_back(std::move(call));
+      }
+    }
+    batch.Reset();
+
+    if (connectionHandle == nullptr) {
+      Callback().Call({Env().Undefined(), results});
+      Callback().Reset();
+      return;
+    }
+
+    // One lane per prepared call, up to concurrency. The first lane gets
+    // the connection already leased, released only when no call prepared.
+    parallel->results = Napi::Persistent(results);
+    parallel->lanes = std::max(
+        (size_t)1, std::min((size_t)concurrency, parallel->calls.size()));
+    Napi::Function callbackFunction = Callback().Value().As<Napi::Function>();
+    for (size_t lane = 0; lane < parallel->lanes; lane++) {
+      (new ParallelLaneAsync(callbackFunction,
+                             pool,
+                             parallel,
+                             lane == 0 ? connectionHandle : nullptr))
+          ->Queue();
+    }
+  }
+
+ private:
+  Pool* pool;
+  Napi::Reference<Napi::Array> batch;
+  uint_t concurrency;
+  std::vector<SAP_UC*> funcNames;
+  std::vector<FunctionDescPtr> functionDescs;
+  std::vector<RFC_ERROR_INFO> errorInfos;
+  RFC_CONNECTION_HANDLE connectionHandle = nullptr;
+  RFC_ERROR_INFO errorInfo;
+};
+
+Napi::Value Pool::InvokeParallel(const Napi::CallbackInfo& info) {
+  if (!info[2].IsFunction()) {
+    Napi::TypeError::New(info.Env(),
+                         "Pool invokeParallel() requires a callback function")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  if (!checkBatch(info[0])) {
+    Napi::TypeError::New(info.Env(),
+                         "Pool invokeParallel() requires an array of "
+                         "{rfm, params} objects")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  // pool connections limit by default
+  uint_t concurrency = ready_high;
+  if (info[1].IsObject()) {
+    Napi::Value value =
+        info[1].As<Napi::Object>().Get(BATCH_OPTION_CONCURRENCY);
+    if (!value.IsUndefined()) {
+      double n = value.IsNumber() ? value.ToNumber().DoubleValue() : 0;
+      if (n < 1 || n != (uint_t)n) {
+        Napi::TypeError::New(info.Env(),
+                             "Pool invokeParallel() option \"" +
+                                 std::string(BATCH_OPTION_CONCURRENCY) +
+                                 "\" must be a positive integer. Received: " +
+                                 value.ToString().Utf8Value())
+            .ThrowAsJavaScriptException();
+        return info.Env().Undefined();
+      }
+      concurrency = (uint_t)n;
+    }
+  }
+
+  _log.debug(logClass::pool, log_id() + " invokeParallel: ", concurrency);
+
+  Napi::Array batch = info[0].As<Napi::Array>();
+  Napi::Function callback = info[2].As<Napi::Function>();
+  (new PrepareParallelAsync(callback, this, batch, concurrency))->Queue();
+
+  return info.Env().Undefined();
+}
+
 uint_t checkArgsAcquire(const Napi::CallbackInfo& info) {
   uint_t clients_requested = 0;
 
@@ -393,6 +687,30 @@ std::string Pool::updateLeasedHandle(RFC_CONNECTION_HANDLE old_handle,
   return errmsg.str();
 }
 
+RFC_CONNECTION_HANDLE Pool::leaseConnection(RFC_ERROR_INFO* errorInfo) {
+  errorInfo->code = RFC_OK;
+  RFC_CONNECTION_HANDLE connectionHandle = nullptr;
+  lockMutex();
+  ConnectionSetType::iterator it = connReady.begin();
+  if (it != connReady.end()) {
+    connectionHandle = *it;
+    connReady.erase(it);
+  }
+  unlockMutex();
+  if (connectionHandle == nullptr) {
+    // opened outside of the lock
+    connectionHandle = RfcOpenConnection(
+        client_params.connectionParams, client_params.paramSize, errorInfo);
+    if (errorInfo->code != RFC_OK) {
+      return nullptr;
+    }
+  }
+  lockMutex();
+  connLeased.insert(connectionHandle);
+  unlockMutex();
+  return connectionHandle;
+}
+
 bool argsCheckReady(const Napi::CallbackInfo& info,
                     uint_t* new_ready,
                     Napi::Function* callback) {
@@ -470,6 +788,7 @@ Napi::Object Pool::Init(Napi::Env env, Napi::Object exports) {
                       InstanceMethod("release", &Pool::Release),
                       InstanceMethod("ready", &Pool::Ready),
                       InstanceMethod("closeAll", &Pool::CloseAll),
+                      InstanceMethod("invokeParallel", &Pool::InvokeParallel),
                   });
 
   Napi::FunctionReference* constructor = new Napi::FunctionReference();
@@ -25,6 +25,8 @@ class Pool : public Napi::ObjectWrap<Pool> {
   friend class ReleaseAsync;
   friend class CheckPoolAsync;
   friend class SetPoolAsync;
+  friend class PrepareParallelAsync;
+  friend class ParallelLaneAsync;
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   // cppcheck-suppress noExplicitConstructor
   Pool(const Napi::CallbackInfo& info);
@@ -38,10 +40,13 @@ class Pool : public Napi::ObjectWrap<Pool> {
   Napi::Value Release(const Napi::CallbackInfo& info);
   Napi::Value Ready(const Napi::CallbackInfo& info);
   Napi::Value CloseAll(const Napi::CallbackInfo& info);
+  Napi::Value InvokeParallel(const Napi::CallbackInfo& info);
   void closeConnections();
   void releaseClient(RFC_CONNECTION_HANDLE connectionHandle);
   std::string updateLeasedHandle(RFC_CONNECTION_HANDLE old_handle,
                                  RFC_CONNECTION_HANDLE new_handle);
+  // Worker thread, ready connection or new one, added to leased
+  RFC_CONNECTION_HANDLE leaseConnection(RFC_ERROR_INFO* errorInfo);
   Napi::ObjectReference poolConfiguration;
   Napi::ObjectReference connectionParameters;
   Napi::ObjectReference clientOptions;
@@ -0,0 +1,527 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ResultBuffer.h"
+#include "Metadata.h"
+#include "Transcode.h"
+
+namespace node_rfc {
+
+////////////////////////////////////////////////////////////////////////////////
+// Extract (worker thread)
+////////////////////////////////////////////////////////////////////////////////
+
+bool ResultBuffer::extract(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
+                           RFC_FUNCTION_HANDLE functionHandle,
+                           const RfmErrorPath* errorPath,
+                           RFC_DIRECTION filter,
+                           uint_t bcd,
+                           int bcdScale) {
+  this->errorPath = *errorPath;
+  this->filter = filter;
+  this->bcd = bcd;
+  this->bcdScale = bcdScale;
+  errorInfo.code = RFC_OK;
+
+  parameterPlan = _metadata.getParameterPlan(functionDescHandle, &errorInfo);
+  if (parameterPlan == nullptr) {
+    return false;
+  }
+
+  for (const FieldBinding& param : parameterPlan->fields) {
+    if ((param.direction & filter) != 0) {
+      continue;
+    }
+    this->errorPath.setParameterName(param.name);
+    if (!extractValue(functionHandle, &param)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const BindingPlan* ResultBuffer::getTypePlan(
+    RFC_TYPE_DESC_HANDLE typeDescHandle) {
+  // Plans are kept until the result is wrapped
+  auto it = typePlans.find(typeDescHandle);
+  if (it != typePlans.end()) {
+    return it->second.get();
+  }
+  BindingPlanPtr plan = _metadata.getTypePlan(typeDescHandle, &errorInfo);
+  if (plan == nullptr) {
+    return nullptr;
+  }
+  typePlans.emplace(typeDescHandle, plan);
+  return plan.get();
+}
+
+bool ResultBuffer::extractStructure(DATA_CONTAINER_HANDLE container,
+                                    const BindingPlan* typePlan) {
+  for (const FieldBinding& field : typePlan->fields) {
+    if (!extractValue(container, &field)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ResultBuffer::extractString(const SAP_UC* uc,
+                                 uint_t length,
+                                 RFCTYPE type) {
+  size_t offset = data.size();
+  bool ascii;
+  if (!appendUtf8(uc, length, &data, &ascii)) {
+    errorMessage = "Non-unicode ABAP string";
+    return false;
+  }
+  ResultValue value;
+  value.type = type;
+  value.ascii = ascii;
+  value.number = false;
+  value.bigint = false;
+  value.length = data.size() - offset;
+  value.offset = offset;
+  values.push_back(value);
+  return true;
+}
+
+bool ResultBuffer::extractValue(DATA_CONTAINER_HANDLE container,
+                                const FieldBinding* field) {
+  RFC_RC rc = RFC_OK;
+  uint_t index = field->index;
+  uint_t cLen = field->nucLength;
+
+  ResultValue value;
+  value.type = field->type;
+  value.length = 0;
+  value.ascii = false;
+  value.number = false;
+  value.bigint = false;
+
+  switch (field->type) {
+    case RFCTYPE_STRUCTURE: {
+      RFC_STRUCTURE_HANDLE structHandle;
+      rc = RfcGetStructureByIndex(container, index, &structHandle, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      value.typePlan = getTypePlan(field->typeDescHandle);
+      if (value.typePlan == nullptr) {
+        rc = errorInfo.code;
+        break;
+      }
+      errorPath.setName(RFCTYPE_STRUCTURE, field->name);
+      values.push_back(value);
+      return extractStructure(structHandle, value.typePlan);
+    }
+    case RFCTYPE_TABLE: {
+      RFC_TABLE_HANDLE tableHandle;
+      rc = RfcGetTableByIndex(container, index, &tableHandle, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      rc = RfcGetRowCount(tableHandle, &value.length, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      value.typePlan = getTypePlan(field->typeDescHandle);
+      if (value.typePlan == nullptr) {
+        rc = errorInfo.code;
+        break;
+      }
+      errorPath.setName(RFCTYPE_TABLE, field->name);
+      values.push_back(value);
+
+      if (value.length > 0) {
+        rc = RfcMoveToFirstRow(tableHandle, &errorInfo);
+      }
+      for (uint_t i = 0; i < value.length && rc == RFC_OK; i++) {
+        errorPath.table_line = i;
+        if (!extractStructure(tableHandle, value.typePlan)) {
+          return false;
+        }
+        if (i + 1 < value.length) {
+          rc = RfcMoveToNextRow(tableHandle, &errorInfo);
+        }
+      }
+      if (rc != RFC_OK) {
+        return false;
+      }
+      return true;
+    }
+    case RFCTYPE_CHAR:
+    case RFCTYPE_NUM: {
+      ucBuffer.resize(cLen);
+      if (field->type == RFCTYPE_CHAR) {
+        rc = RfcGetCharsByIndex(
+            container, index, ucBuffer.data(), cLen, &errorInfo);
+      } else {
+        rc = RfcGetNumByIndex(
+            container, index, ucBuffer.data(), cLen, &errorInfo);
+      }
+      if (rc != RFC_OK) {
+        break;
+      }
+      return extractString(ucBuffer.data(), cLen, field->type);
+    }
+    case RFCTYPE_STRING: {
+      uint_t resultLen = 0, strLen = 0;
+      RfcGetStringLengthByIndex(container, index, &strLen, &errorInfo);
+      ucBuffer.resize(strLen + 1);
+      rc = RfcGetStringByIndex(container,
+                               index,
+                               ucBuffer.data(),
+                               strLen + 1,
+                               &resultLen,
+                               &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      return extractString(ucBuffer.data(), strLen, field->type);
+    }
+    case RFCTYPE_BYTE: {
+      value.offset = data.size();
+      value.length = cLen;
+      data.resize(value.offset + cLen);
+      rc = RfcGetBytesByIndex(container,
+                              index,
+                              reinterpret_cast<SAP_RAW*>(&data[value.offset]),
+                              cLen,
+                              &errorInfo);
+      break;
+    }
+    case RFCTYPE_XSTRING: {
+      uint_t strLen, resultLen = 0;
+      RfcGetStringLengthByIndex(container, index, &strLen, &errorInfo);
+      value.offset = data.size();
+      data.resize(value.offset + strLen);
+      rc = RfcGetXStringByIndex(container,
+                                index,
+                                reinterpret_cast<SAP_RAW*>(&data[value.offset]),
+                                strLen,
+                                &resultLen,
+                                &errorInfo);
+      value.length = resultLen;
+      data.resize(value.offset + resultLen);
+      break;
+    }
+    case RFCTYPE_BCD:
+    case RFCTYPE_DECF16:
+    case RFCTYPE_DECF34: {
+      // String representation upper bound: (2*cLen)-1 digits, sign and
+      // decimal separator, exponent char, sign and exponent for DECF
+      uint_t resultLen;
+      uint_t strLen = field->type == RFCTYPE_BCD ? 2 * cLen + 1 : 2 * cLen + 10;
+      ucBuffer.resize(strLen + 1);
+      rc = RfcGetStringByIndex(container,
+                               index,
+                               ucBuffer.data(),
+                               strLen + 1,
+                               &resultLen,
+                               &errorInfo);
+      if (rc == RFC_BUFFER_TOO_SMALL) {
+        // use returned requried result length
+        _log.warning(logClass::nwrfc,
+                     "Buffer for BCD type ",
+                     field->type,
+                     " too small, for field index ",
+                     index);
+        strLen = resultLen;
+        ucBuffer.resize(strLen + 1);
+        rc = RfcGetStringByIndex(container,
+                                 index,
+                                 ucBuffer.data(),
+                                 strLen + 1,
+                                 &resultLen,
+                                 &errorInfo);
+      }
+      if (rc != RFC_OK) {
+        break;
+      }
+      if (bcd == CLIENT_OPTION_BCD_NUMBER &&
+          parseDecimal(ucBuffer.data(), resultLen, &value.floatValue)) {
+        value.number = true;
+        break;
+      }
+      std::vector<uint64_t> words;
+      if (bcd == CLIENT_OPTION_BCD_SCALED_BIGINT &&
+          decimalToWords(ucBuffer.data(),
+                         resultLen,
+                         bcdScale >= 0 ? bcdScale : field->decimals,
+                         &value.negative,
+                         &words)) {
+        value.bigint = true;
+        value.offset = data.size();
+        value.length = words.size();
+        data.append(reinterpret_cast<const char*>(words.data()),
+                    words.size() * sizeof(uint64_t));
+        break;
+      }
+      return extractString(ucBuffer.data(), resultLen, field->type);
+    }
+    case RFCTYPE_FLOAT: {
+      rc = RfcGetFloatByIndex(container, index, &value.floatValue, &errorInfo);
+      break;
+    }
+    case RFCTYPE_INT: {
+      RFC_INT intValue;
+      rc = RfcGetIntByIndex(container, index, &intValue, &errorInfo);
+      value.intValue = intValue;
+      break;
+    }
+    case RFCTYPE_INT1: {
+      RFC_INT1 intValue;
+      rc = RfcGetInt1ByIndex(container, index, &intValue, &errorInfo);
+      value.intValue = intValue;
+      break;
+    }
+    case RFCTYPE_INT2: {
+      RFC_INT2 intValue;
+      rc = RfcGetInt2ByIndex(container, index, &intValue, &errorInfo);
+      value.intValue = intValue;
+      break;
+    }
+    case RFCTYPE_INT8: {
+      RFC_INT8 intValue;
+      rc = RfcGetInt8ByIndex(container, index, &intValue, &errorInfo);
+      value.intValue = intValue;
+      break;
+    }
+    case RFCTYPE_UTCLONG: {
+      uint_t resultLen = 0, strLen = 27;
+      ucBuffer.resize(strLen + 1);
+      rc = RfcGetStringByIndex(container,
+                               index,
+                               ucBuffer.data(),
+                               strLen + 1,
+                               &resultLen,
+                               &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      ucBuffer[19] = '.';
+      return extractString(ucBuffer.data(), strLen, field->type);
+    }
+    case RFCTYPE_DATE: {
+      RFC_DATE dateValue;
+      rc = RfcGetDateByIndex(container, index, dateValue, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      return extractString(dateValue, 8, field->type);
+    }
+    case RFCTYPE_TIME: {
+      RFC_TIME timeValue;
+      rc = RfcGetTimeByIndex(container, index, timeValue, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
+      return extractString(timeValue, 6, field->type);
+    }
+    default:
+      errorPath.setName(field->type, field->name);
+      errorMessage =
+          "RFC type from ABAP not supported" + std::to_string(field->type);
+      return false;
+  }
+
+  if (rc != RFC_OK) {
+    errorPath.setName(field->type, field->name);
+    return false;
+  }
+
+  values.push_back(value);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Wrap (main thread)
+////////////////////////////////////////////////////////////////////////////////
+
+ValuePair ResultBuffer::wrap(ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  if (errorInfo.code != RFC_OK) {
+    return ValuePair(scope.Escape(rfcSdkError(&errorInfo, &errorPath)),
+                     ENV_UNDEFINED);
+  }
+  if (!errorMessage.empty()) {
+    return ValuePair(scope.Escape(nodeRfcError(errorMessage, &errorPath)),
+                     ENV_UNDEFINED);
+  }
+
+  Napi::Object resultObj = Napi::Object::New(node_rfc::__env);
+  next = 0;
+  for (const FieldBinding& param : parameterPlan->fields) {
+    if ((param.direction & filter) == 0) {
+      resultObj.Set(wrapString(param.name), wrapValue(client_options));
+    }
+  }
+  return ValuePair(ENV_UNDEFINED, scope.Escape(resultObj));
+}
+
+Napi::Value ResultBuffer::wrapStructure(const BindingPlan* typePlan,
+                                        ClientOptionsStruct* client_options) {
+  // Elementary line type table has one field only, with empty name
+  if (typePlan->fields.size() == 1 && *typePlan->fields[0].name == 0) {
+    return wrapValue(client_options);
+  }
+
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+  ArenaScope arena;
+  uint_t fieldCount = typePlan->fields.size();
+  napi_property_descriptor* properties =
+      arena.alloc<napi_property_descriptor>(fieldCount);
+  for (uint_t i = 0; i < fieldCount; i++) {
+    Napi::Value name = fieldKeys.get(typePlan->typeDescHandle,
+                                     fieldCount,
+                                     i,
+                                     typePlan->fields[i].name);
+    properties[i] = dataProperty(name, wrapValue(client_options));
+  }
+  return scope.Escape(newObject(properties, fieldCount));
+}
+
+Napi::Value ResultBuffer::wrapColumns(const ResultValue& table,
+                                      ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  const BindingPlan* typePlan = table.typePlan;
+  uint_t fieldCount = typePlan->fields.size();
+  uint_t rowCount = table.length;
+
+  ExportColumns columns;
+  Napi::Object resultObj = columns.init(typePlan, rowCount, client_options);
+
+  for (uint_t i = 0; i < rowCount; i++) {
+    for (uint_t f = 0; f < fieldCount; f++) {
+      if (columns.intColumns[f] != nullptr) {
+        columns.intColumns[f][i] =
+            static_cast<int32_t>(values[next++].intValue);
+      } else if (columns.int8Columns[f] != nullptr) {
+        columns.int8Columns[f][i] = values[next++].intValue;
+      } else if (columns.floatColumns[f] != nullptr) {
+        columns.floatColumns[f][i] = values[next++].floatValue;
+      } else {
+        columns.columns[f].Set(i, wrapValue(client_options));
+      }
+    }
+  }
+
+  return scope.Escape(resultObj);
+}
+
+Napi::Value ResultBuffer::wrapValue(ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+  Napi::Value resultValue;
+
+  const ResultValue& value = values[next++];
+  switch (value.type) {
+    case RFCTYPE_STRUCTURE:
+      resultValue = wrapStructure(value.typePlan, client_options);
+      break;
+    case RFCTYPE_TABLE: {
+      if (client_options->table == CLIENT_OPTION_TABLE_COLUMNS) {
+        resultValue = wrapColumns(value, client_options);
+        break;
+      }
+      // Appended in index order, not preallocated, see getVariable()
+      Napi::Array table = Napi::Array::New(node_rfc::__env);
+      for (uint_t i = 0; i < value.length; i++) {
+        table.Set(i, wrapStructure(value.typePlan, client_options));
+      }
+      resultValue = table;
+      break;
+    }
+    case RFCTYPE_BYTE:
+    case RFCTYPE_XSTRING:
+      resultValue = Napi::Buffer<SAP_RAW>::Copy(
+          node_rfc::__env,
+          reinterpret_cast<const SAP_RAW*>(data.data() + value.offset),
+          value.length);
+      break;
+    case RFCTYPE_BCD:
+    case RFCTYPE_DECF16:
+    case RFCTYPE_DECF34:
+      if (value.number) {
+        resultValue = Napi::Number::New(node_rfc::__env, value.floatValue);
+        break;
+      }
+      if (value.bigint) {
+        // data not aligned for uint64_t
+        std::vector<uint64_t> words(value.length);
+        memcpy(words.data(),
+               data.data() + value.offset,
+               value.length * sizeof(uint64_t));
+        resultValue = Napi::BigInt::New(node_rfc::__env,
+                                        value.negative ? 1 : 0,
+                                        words.size(),
+                                        words.data());
+        break;
+      }
+      resultValue = newString(
+          data.data() + value.offset, value.length, value.ascii);
+      if (client_options->bcd == CLIENT_OPTION_BCD_FUNCTION) {
+        resultValue = client_options->bcdFunction.Call({resultValue});
+      } else if (client_options->bcd == CLIENT_OPTION_BCD_NUMBER) {
+        resultValue = resultValue.ToNumber();
+      }
+      break;
+    case RFCTYPE_FLOAT:
+      resultValue = Napi::Number::New(node_rfc::__env, value.floatValue);
+      break;
+    case RFCTYPE_INT8:
+      if (client_options->bigint) {
+        resultValue = Napi::BigInt::New(node_rfc::__env, value.intValue);
+        break;
+      }
+      // fallthrough
+    case RFCTYPE_INT:
+    case RFCTYPE_INT1:
+    case RFCTYPE_INT2:
+      resultValue = Napi::Number::New(node_rfc::__env,
+                                      static_cast<double>(value.intValue));
+      break;
+    case RFCTYPE_DATE:
+      if (client_options->datePreset != CLIENT_OPTION_DATETIME_STRING) {
+        // blank date trimmed to empty string
+        if (value.length == 8) {
+          resultValue =
+              wrapDate(data.data() + value.offset, client_options->datePreset);
+        } else {
+          resultValue = node_rfc::__env.Null();
+        }
+        break;
+      }
+      resultValue = newString(
+          data.data() + value.offset, value.length, value.ascii);
+      if (!client_options->dateFromABAP.IsEmpty()) {
+        resultValue = client_options->dateFromABAP.Call({resultValue});
+      }
+      break;
+    case RFCTYPE_TIME:
+      if (client_options->timePreset != CLIENT_OPTION_DATETIME_STRING) {
+        if (value.length == 6) {
+          resultValue =
+              wrapTime(data.data() + value.offset, client_options->timePreset);
+        } else {
+          resultValue = node_rfc::__env.Null();
+        }
+        break;
+      }
+      resultValue = newString(
+          data.data() + value.offset, value.length, value.ascii);
+      if (!client_options->timeFromABAP.IsEmpty()) {
+        resultValue = client_options->timeFromABAP.Call({resultValue});
+      }
+      break;
+    default:
+      // CHAR, NUM, STRING, UTCLONG
+      resultValue = newString(
+          data.data() + value.offset, value.length, value.ascii);
+  }
+  return scope.Escape(resultValue);
+}
+
+}  // namespace node_rfc
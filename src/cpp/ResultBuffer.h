@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_ResultBuffer_H
+#define NodeRfc_ResultBuffer_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Log.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+//
+// Extracted ABAP value. Strings and bytes are stored in the buffer data,
+// structure and table values are followed by their field values.
+//
+typedef struct _ResultValue {
+  RFCTYPE type;
+  uint_t length;  // data bytes or table rows
+  bool ascii;     // string data, one byte per character
+  bool number;    // decimal read into floatValue
+  bool bigint;    // scaled decimal, 64 bit words in data
+  bool negative;  // scaled decimal sign
+  union {
+    int64_t intValue;
+    double floatValue;
+    size_t offset;
+    const BindingPlan* typePlan;  // structure and table
+  };
+} ResultValue;
+
+//
+// Function call result, extracted from SDK in worker thread, converted
+// to NodeJS values in main thread.
+//
+class ResultBuffer {
+ public:
+  // Worker thread, no NodeJS API used
+  bool extract(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
+               RFC_FUNCTION_HANDLE functionHandle,
+               const RfmErrorPath* errorPath,
+               RFC_DIRECTION filter,
+               uint_t bcd,
+               int bcdScale);
+
+  // Main thread
+  ValuePair wrap(ClientOptionsStruct* client_options);
+
+ private:
+  bool extractStructure(DATA_CONTAINER_HANDLE container,
+                        const BindingPlan* typePlan);
+  bool extractValue(DATA_CONTAINER_HANDLE container,
+                    const FieldBinding* field);
+  bool extractString(const SAP_UC* uc, uint_t length, RFCTYPE type);
+  const BindingPlan* getTypePlan(RFC_TYPE_DESC_HANDLE typeDescHandle);
+
+  Napi::Value wrapStructure(const BindingPlan* typePlan,
+                            ClientOptionsStruct* client_options);
+  Napi::Value wrapColumns(const ResultValue& table,
+                          ClientOptionsStruct* client_options);
+  Napi::Value wrapValue(ClientOptionsStruct* client_options);
+
+  BindingPlanPtr parameterPlan;
+  std::unordered_map<RFC_TYPE_DESC_HANDLE, BindingPlanPtr> typePlans;
+  RFC_DIRECTION filter;
+  uint_t bcd;
+  int bcdScale;
+
+  FieldKeys fieldKeys;
+
+  std::vector<ResultValue> values;
+  std::string data;
+  std::vector<SAP_UC> ucBuffer;
+  size_t next = 0;
+
+  RFC_ERROR_INFO errorInfo;
+  std::string errorMessage;
+  RfmErrorPath errorPath;
+};
+
+}  // namespace node_rfc
+
+#endif
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TableCursor.h"
+#include "Metadata.h"
+
+namespace node_rfc {
+
+Napi::FunctionReference TableCursor::constructor;
+
+TableCursor::TableCursor(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<TableCursor>(info) {
+  if (!info.IsConstructCall()) {
+    Napi::Error::New(
+        info.Env(),
+        "Use the new operator to create instances of Rfc TableCursor.")
+        .ThrowAsJavaScriptException();
+  }
+  errorPath.clear();
+}
+
+TableCursor::~TableCursor(void) {
+  close();
+}
+
+Napi::Object TableCursor::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(
+      env,
+      "TableCursor",
+      {
+          InstanceAccessor("tables", &TableCursor::TablesGetter, nullptr),
+          InstanceMethod("read", &TableCursor::Read),
+          InstanceMethod("close", &TableCursor::Close),
+      });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  // Created by Client invokeStream() only, not exported
+  return exports;
+}
+
+ValuePair TableCursor::NewInstance(RFC_FUNCTION_HANDLE functionHandle,
+                                   FunctionDescPtr functionDesc,
+                                   RfmErrorPath* errorPath,
+                                   ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  Napi::Object cursorObj = constructor.New({});
+  TableCursor* cursor = TableCursor::Unwrap(cursorObj);
+  cursor->functionHandle = functionHandle;
+  cursor->functionDesc = functionDesc;
+  cursor->errorPath = *errorPath;
+  cursor->client_options = *client_options;
+
+  Napi::Value error = cursor->getParameters(functionDesc->handle);
+  if (!error.IsUndefined()) {
+    cursor->close();
+    return ValuePair(scope.Escape(error), ENV_UNDEFINED);
+  }
+  return ValuePair(ENV_UNDEFINED, scope.Escape(cursorObj));
+}
+
+// Reads non-table parameters into the "result" property and registers
+// table parameters for chunked reading
+Napi::Value TableCursor::getParameters(
+    RFC_FUNCTION_DESC_HANDLE functionDescHandle) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  RFC_ERROR_INFO errorInfo;
+  BindingPlanPtr plan =
+      _metadata.getParameterPlan(functionDescHandle, &errorInfo);
+  if (plan == nullptr) {
+    return scope.Escape(rfcSdkError(&errorInfo, &errorPath));
+  }
+
+  Napi::Object resultObj = Napi::Object::New(node_rfc::__env);
+
+  for (const FieldBinding& param : plan->fields) {
+    if ((param.direction & client_options.filter_param_type) != 0) {
+      continue;
+    }
+    errorPath.setParameterName(param.name);
+    if (param.type != RFCTYPE_TABLE) {
+      ValuePair result = getVariable(param.type,
+                                     functionHandle,
+                                     param.name,
+                                     param.nucLength,
+                                     param.decimals,
+                                     param.typeDescHandle,
+                                     &errorPath,
+                                     &client_options);
+      if (!result.first.IsUndefined()) {
+        return scope.Escape(result.first);
+      }
+      resultObj.Set(wrapString(param.name), result.second);
+      continue;
+    }
+
+    CursorTable table;
+    strcpyU(table.cName, param.name);
+    table.name = wrapString(param.name).As<Napi::String>().Utf8Value();
+    table.position = 0;
+    table.typePlan = _metadata.getTypePlan(param.typeDescHandle, &errorInfo);
+    if (table.typePlan == nullptr ||
+        RfcGetTable(functionHandle,
+                    param.name,
+                    &table.tableHandle,
+                    &errorInfo) != RFC_OK ||
+        RfcGetRowCount(table.tableHandle, &table.rowCount, &errorInfo) !=
+            RFC_OK) {
+      errorPath.setName(RFCTYPE_TABLE, param.name);
+      return scope.Escape(rfcSdkError(&errorInfo, &errorPath));
+    }
+    tables.push_back(table);
+  }
+
+  Value().Set("result", resultObj);
+  return scope.Escape(ENV_UNDEFINED);
+}
+
+void TableCursor::close() {
+  if (functionHandle != nullptr) {
+    RfcDestroyFunction(functionHandle, nullptr);
+    functionHandle = nullptr;
+  }
+  functionDesc.reset();
+  tables.clear();
+}
+
+Napi::Value TableCursor::TablesGetter(const Napi::CallbackInfo& info) {
+  Napi::Object tablesObj = Napi::Object::New(info.Env());
+  for (const CursorTable& table : tables) {
+    tablesObj.Set(table.name, Napi::Number::New(info.Env(), table.rowCount));
+  }
+  return tablesObj;
+}
+
+// Returns the next rows of the table, an empty array when all rows read
+Napi::Value TableCursor::Read(const Napi::CallbackInfo& info) {
+  Napi::EscapableHandleScope scope(info.Env());
+
+  if (!info[0].IsString() || !info[1].IsNumber()) {
+    Napi::TypeError::New(info.Env(),
+                         "TableCursor read() requires table name and count")
+        .ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+
+  std::string name = info[0].As<Napi::String>().Utf8Value();
+  uint_t count = info[1].As<Napi::Number>().Uint32Value();
+
+  CursorTable* table = nullptr;
+  for (CursorTable& t : tables) {
+    if (t.name == name) {
+      table = &t;
+      break;
+    }
+  }
+  if (table == nullptr) {
+    return scope.Escape(nodeRfcError("Table not found in the result: " + name,
+                                     &errorPath));
+  }
+
+  Napi::Array rows = Napi::Array::New(info.Env());
+  uint_t end = table->rowCount - table->position < count
+                   ? table->rowCount
+                   : table->position + count;
+
+  RFC_RC rc = RFC_OK;
+  RFC_ERROR_INFO errorInfo;
+  errorPath.setParameterName(table->cName);
+  errorPath.setName(RFCTYPE_TABLE, table->cName);
+
+  if (table->position < end) {
+    rc = RfcMoveTo(table->tableHandle, table->position, &errorInfo);
+  }
+  for (uint_t i = 0; table->position < end && rc == RFC_OK; i++) {
+    errorPath.table_line = table->position;
+    ValuePair result = getStructure(table->typePlan.get(),
+                                    table->tableHandle,
+                                    &errorPath,
+                                    &client_options,
+                                    &fieldKeys);
+    if (!result.first.IsUndefined()) {
+      return scope.Escape(result.first);
+    }
+    rows.Set(i, result.second);
+    if (++table->position < end) {
+      rc = RfcMoveToNextRow(table->tableHandle, &errorInfo);
+    }
+  }
+  if (rc != RFC_OK) {
+    return scope.Escape(rfcSdkError(&errorInfo, &errorPath));
+  }
+
+  return scope.Escape(rows);
+}
+
+Napi::Value TableCursor::Close(const Napi::CallbackInfo& info) {
+  close();
+  return info.Env().Undefined();
+}
+
+}  // namespace node_rfc
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_TableCursor_H
+#define NodeRfc_TableCursor_H
+
+#include <string>
+#include <vector>
+#include "Log.h"
+#include "Metadata.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+//
+// Table parameter of the streamed function call result
+//
+typedef struct _CursorTable {
+  std::string name;
+  RFC_ABAP_NAME cName;
+  BindingPlanPtr typePlan;
+  RFC_TABLE_HANDLE tableHandle;
+  uint_t rowCount;
+  uint_t position;
+} CursorTable;
+
+//
+// Reads table parameters of the invoked function in chunks, after the
+// connection is released. Owns the function handle, destroyed by close().
+//
+class TableCursor : public Napi::ObjectWrap<TableCursor> {
+ public:
+  static Napi::FunctionReference constructor;
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  // Takes over the function handle, also when the error is returned
+  static ValuePair NewInstance(RFC_FUNCTION_HANDLE functionHandle,
+                               FunctionDescPtr functionDesc,
+                               RfmErrorPath* errorPath,
+                               ClientOptionsStruct* client_options);
+  // cppcheck-suppress noExplicitConstructor
+  TableCursor(const Napi::CallbackInfo& info);
+  ~TableCursor(void);
+
+ private:
+  Napi::Value TablesGetter(const Napi::CallbackInfo& info);
+  Napi::Value Read(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+
+  Napi::Value getParameters(RFC_FUNCTION_DESC_HANDLE functionDescHandle);
+  void close();
+
+  RFC_FUNCTION_HANDLE functionHandle = nullptr;
+  // kept until the function handle is destroyed
+  FunctionDescPtr functionDesc;
+  std::vector<CursorTable> tables;
+  FieldKeys fieldKeys;
+
+  RfmErrorPath errorPath;
+  ClientOptionsStruct client_options;
+};
+
+}  // namespace node_rfc
+
+#endif
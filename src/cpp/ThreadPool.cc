@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ThreadPool.h"
+#include <thread>
+
+namespace node_rfc {
+
+void RfcWorker::Queue() {
+  if (_threadPool.getSize() == 0) {
+    Napi::AsyncWorker::Queue();
+    return;
+  }
+  _threadPool.queue(this);
+}
+
+void RfcWorker::complete() {
+  // NodeJS exceptions thrown in callbacks are re-thrown in NodeJS,
+  // like from Napi::AsyncWorker
+  try {
+    OnOK();
+  } catch (const Napi::Error& e) {
+    e.ThrowAsJavaScriptException();
+  }
+  delete this;
+}
+
+void completeRfcWorker(Napi::Env env,
+                       Napi::Function callback,
+                       void* context,
+                       RfcWorker* worker) {
+  UNUSED(callback);
+  UNUSED(context);
+  if (env == nullptr) {
+    // NodeJS environment teardown
+    return;
+  }
+  _threadPool.done(env);
+  worker->complete();
+}
+
+void ThreadPool::start(Napi::Env env) {
+  completion =
+      RfcCompletion::New(env, Napi::Function(), "nodeRfcThreadPool", 0, 1);
+  // NodeJS kept alive only when RFC calls are active
+  completion.Unref(env);
+  napi_add_env_cleanup_hook(env, cleanup, this);
+  started = true;
+}
+
+void ThreadPool::cleanup(void* arg) {
+  ThreadPool* pool = static_cast<ThreadPool*>(arg);
+  std::lock_guard<std::mutex> lock(pool->queueMutex);
+  pool->stopped = true;
+  pool->completion.Release();
+  pool->queueReady.notify_all();
+}
+
+void ThreadPool::queue(RfcWorker* worker) {
+  if (!started) {
+    start(worker->Env());
+  }
+  if (active++ == 0) {
+    completion.Ref(worker->Env());
+  }
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    workers.push_back(worker);
+    // threads started at first use
+    while (threads < size) {
+      threads++;
+      std::thread(&ThreadPool::run, this).detach();
+    }
+  }
+  queueReady.notify_one();
+}
+
+void ThreadPool::done(Napi::Env env) {
+  completed++;
+  if (--active == 0) {
+    completion.Unref(env);
+  }
+}
+
+void ThreadPool::run() {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  while (true) {
+    queueReady.wait(lock, [this] {
+      return stopped || !workers.empty() || threads > size;
+    });
+    // when shrinking, the last thread drains the queue
+    if (stopped || (threads > size && (workers.empty() || threads > 1))) {
+      threads--;
+      return;
+    }
+    RfcWorker* worker = workers.front();
+    workers.pop_front();
+    lock.unlock();
+
+    worker->run();
+
+    lock.lock();
+    if (stopped) {
+      // completion released in cleanup
+      threads--;
+      return;
+    }
+    completion.NonBlockingCall(worker);
+  }
+}
+
+void ThreadPool::setSize(uint_t size) {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    this->size = size;
+    // running pool resized now, otherwise at first use
+    while (threads > 0 && threads < size) {
+      threads++;
+      std::thread(&ThreadPool::run, this).detach();
+    }
+  }
+  queueReady.notify_all();
+}
+
+uint_t ThreadPool::getSize() {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return size;
+}
+
+Napi::Value ThreadPool::status(Napi::Env env) {
+  Napi::EscapableHandleScope scope(env);
+  Napi::Object status = Napi::Object::New(env);
+  std::lock_guard<std::mutex> lock(queueMutex);
+  status.Set("size", Napi::Number::New(env, size));
+  status.Set("threads", Napi::Number::New(env, threads));
+  status.Set("pending", Napi::Number::New(env, (double)workers.size()));
+  status.Set("active", Napi::Number::New(env, (double)active));
+  status.Set("completed", Napi::Number::New(env, (double)completed));
+  return scope.Escape(status);
+}
+
+Napi::Value SetRfcThreadPoolSize(const Napi::CallbackInfo& info) {
+  double size = info[0].IsNumber() ? info[0].ToNumber().DoubleValue() : -1;
+  if (size < 0 || size > RFC_THREADPOOL_SIZE_MAX || size != (uint_t)size) {
+    char errmsg[ERRMSG_LENGTH];
+    snprintf(errmsg,
+             ERRMSG_LENGTH - 1,
+             "setRfcThreadPoolSize() requires an integer from 0 to %u",
+             RFC_THREADPOOL_SIZE_MAX);
+    Napi::TypeError::New(info.Env(), errmsg).ThrowAsJavaScriptException();
+    return info.Env().Undefined();
+  }
+  _threadPool.setSize((uint_t)size);
+  return info.Env().Undefined();
+}
+
+Napi::Value RfcThreadPoolStatus(const Napi::CallbackInfo& info) {
+  return _threadPool.status(info.Env());
+}
+
+Napi::Object ThreadPool::Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("setRfcThreadPoolSize",
+              Napi::Function::New(env, SetRfcThreadPoolSize));
+  exports.Set("rfcThreadPoolStatus",
+              Napi::Function::New(env, RfcThreadPoolStatus));
+  return exports;
+}
+
+// Create RFC threadpool instance, never destroyed: detached threads may
+// still wait on it at process exit
+ThreadPool& _threadPool = *new ThreadPool();
+
+}  // namespace node_rfc
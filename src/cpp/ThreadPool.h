@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_ThreadPool_H
+#define NodeRfc_ThreadPool_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "Log.h"
+#include "nwrfcsdk.h"
+
+namespace node_rfc {
+
+extern Napi::Env __env;
+extern Log _log;
+
+// Default number of RFC threads, 0 for libuv threadpool
+#define RFC_THREADPOOL_SIZE_DEFAULT 4
+#define RFC_THREADPOOL_SIZE_MAX 128
+
+class RfcWorker;
+
+void completeRfcWorker(Napi::Env env,
+                       Napi::Function callback,
+                       void* context,
+                       RfcWorker* worker);
+
+typedef Napi::TypedThreadSafeFunction<void, RfcWorker, completeRfcWorker>
+    RfcCompletion;
+
+//
+// Async worker for blocking SAP NW RFC SDK calls. Execute() runs in the
+// RFC threadpool, OnOK() in the main thread, like with Napi::AsyncWorker.
+//
+class RfcWorker : public Napi::AsyncWorker {
+ public:
+  explicit RfcWorker(const Napi::Function& callback)
+      : Napi::AsyncWorker(callback) {}
+
+  // Queued to the RFC threadpool, or to libuv threadpool if the RFC
+  // threadpool size is set to 0
+  void Queue();
+
+ private:
+  friend class ThreadPool;
+  friend void completeRfcWorker(Napi::Env env,
+                                Napi::Function callback,
+                                void* context,
+                                RfcWorker* worker);
+  void run() { Execute(); }
+  void complete();
+};
+
+//
+// Native threads for RFC round trips, shared by all Client and Pool
+// instances. Slow ABAP calls do not occupy the libuv threadpool, used
+// by NodeJS for fs, dns and crypto.
+//
+class ThreadPool {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // Main thread
+  void queue(RfcWorker* worker);
+  void setSize(uint_t size);
+  uint_t getSize();
+  Napi::Value status(Napi::Env env);
+
+ private:
+  friend void completeRfcWorker(Napi::Env env,
+                                Napi::Function callback,
+                                void* context,
+                                RfcWorker* worker);
+  static void cleanup(void* arg);
+  void start(Napi::Env env);
+  void run();
+  void done(Napi::Env env);
+
+  std::mutex queueMutex;
+  std::condition_variable queueReady;
+  std::deque<RfcWorker*> workers;
+  uint_t size = RFC_THREADPOOL_SIZE_DEFAULT;
+  uint_t threads = 0;
+  bool stopped = false;
+
+  // Main thread only
+  RfcCompletion completion;
+  bool started = false;
+  size_t active = 0;
+  uint64_t completed = 0;
+};
+
+extern ThreadPool& _threadPool;
+
+}  // namespace node_rfc
+
+#endif
@@ -0,0 +1,404 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Transcode.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// NODE_RFC_SCALAR forces the scalar loops, for benchmarks
+#if (defined(__SSE2__) || defined(_M_X64) || \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && \
+    !defined(NODE_RFC_SCALAR)
+#define NODE_RFC_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace node_rfc {
+
+static_assert(sizeof(SAP_UC) == 2, "SAP unicode expected as UTF-16");
+
+namespace {
+
+// isspace() in C locale
+inline bool isBlank(uint16_t c) {
+  return c == 0x20 || (c >= 0x09 && c <= 0x0d);
+}
+
+inline uint_t highestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return index;
+#else
+  return 31 - __builtin_clz(mask);
+#endif
+}
+
+}  // namespace
+
+bool transcodeToUtf8(const SAP_UC* uc,
+                     uint_t length,
+                     RFC_BYTE* utf8,
+                     uint_t* utf8Length,
+                     bool* ascii) {
+  const uint16_t* in = reinterpret_cast<const uint16_t*>(uc);
+  uint_t i = 0;
+  uint_t out = 0;
+  // output length up to the last non-blank
+  uint_t trimmed = 0;
+
+  while (i < length) {
+#if defined(NODE_RFC_SSE2)
+    // 8 ASCII characters per step
+    const __m128i nonAscii = _mm_set1_epi16(-0x80);
+    const __m128i space = _mm_set1_epi16(0x20);
+    const __m128i tab = _mm_set1_epi16(0x08);
+    const __m128i cr = _mm_set1_epi16(0x0e);
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 8 <= length) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonAscii),
+                                            zero)) != 0xffff) {
+        break;
+      }
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(utf8 + out),
+                       _mm_packus_epi16(v, v));
+      __m128i blank =
+          _mm_or_si128(_mm_cmpeq_epi16(v, space),
+                       _mm_and_si128(_mm_cmpgt_epi16(v, tab),
+                                     _mm_cmplt_epi16(v, cr)));
+      uint32_t nonBlank = ~_mm_movemask_epi8(blank) & 0xffff;
+      if (nonBlank != 0) {
+        trimmed = out + (highestBit(nonBlank) >> 1) + 1;
+      }
+      i += 8;
+      out += 8;
+    }
+#endif
+    if (i == length) {
+      break;
+    }
+
+    uint16_t c = in[i++];
+    if (c < 0x80) {
+      utf8[out++] = static_cast<RFC_BYTE>(c);
+      if (!isBlank(c)) {
+        trimmed = out;
+      }
+    } else if (c < 0x800) {
+      utf8[out++] = static_cast<RFC_BYTE>(0xc0 | (c >> 6));
+      utf8[out++] = static_cast<RFC_BYTE>(0x80 | (c & 0x3f));
+      trimmed = out;
+    } else if (c >= 0xd800 && c <= 0xdfff) {
+      return false;
+    } else {
+      utf8[out++] = static_cast<RFC_BYTE>(0xe0 | (c >> 12));
+      utf8[out++] = static_cast<RFC_BYTE>(0x80 | ((c >> 6) & 0x3f));
+      utf8[out++] = static_cast<RFC_BYTE>(0x80 | (c & 0x3f));
+      trimmed = out;
+    }
+  }
+
+  *utf8Length = trimmed;
+  if (ascii != nullptr) {
+    // one byte per character
+    *ascii = out == length;
+  }
+  return true;
+}
+
+bool transcodeToSAPUC(const RFC_BYTE* utf8,
+                      uint_t length,
+                      SAP_UC* uc,
+                      uint_t* ucLength) {
+  uint16_t* out = reinterpret_cast<uint16_t*>(uc);
+  uint_t i = 0;
+
+#if defined(NODE_RFC_SSE2)
+  // 16 characters per step
+  const __m128i zero = _mm_setzero_si128();
+  while (i + 16 <= length) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8 + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      return false;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8),
+                     _mm_unpackhi_epi8(v, zero));
+    i += 16;
+  }
+#endif
+  for (; i < length; i++) {
+    if (utf8[i] & 0x80) {
+      return false;
+    }
+    out[i] = utf8[i];
+  }
+
+  *ucLength = length;
+  return true;
+}
+
+bool parseDecimal(const SAP_UC* uc, uint_t length, double* number) {
+  // Digits, sign, decimal separator and exponent only
+  char digits[64];
+  if (length == 0 || length >= sizeof(digits)) {
+    return false;
+  }
+  for (uint_t i = 0; i < length; i++) {
+    uint16_t c = uc[i];
+    if (!((c >= '0' && c <= '9') || c == '.' || c == '+' || c == '-' ||
+          c == 'e' || c == 'E')) {
+      return false;
+    }
+    digits[i] = static_cast<char>(c);
+  }
+  digits[length] = 0;
+
+  char* end;
+  *number = strtod(digits, &end);
+  return end == digits + length;
+}
+
+bool formatDecimal(double number, SAP_UC* uc, uint_t* ucLength) {
+  if (!std::isfinite(number)) {
+    return false;
+  }
+  uint_t out = 0;
+  if (number == 0) {
+    uc[out++] = '0';
+    *ucLength = out;
+    return true;
+  }
+  if (number < 0) {
+    uc[out++] = '-';
+    number = -number;
+  }
+
+  // Shortest of 15, 16 and 17 significant digits which reads back the same,
+  // any shorter reads back too, subnormals excepted
+  char buffer[32];
+  for (int precision = number < DBL_MIN ? 1 : 15; precision <= 17;
+       precision++) {
+    snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, number);
+    if (strtod(buffer, nullptr) == number) {
+      break;
+    }
+  }
+
+  // d.ddde[+-]x: significant digits, trailing zeros removed, and the decimal
+  // point position, value = 0.digits * 10^point
+  char digits[20];
+  int count = 0;
+  const char* p = buffer;
+  for (; *p != 'e'; p++) {
+    if (*p >= '0' && *p <= '9') {
+      digits[count++] = *p;
+    }
+  }
+  while (count > 1 && digits[count - 1] == '0') {
+    count--;
+  }
+  int point = atoi(p + 1) + 1;
+
+  if (count <= point && point <= 21) {
+    // integer
+    for (int i = 0; i < count; i++) uc[out++] = digits[i];
+    for (int i = count; i < point; i++) uc[out++] = '0';
+  } else if (0 < point && point <= 21) {
+    // fraction
+    for (int i = 0; i < point; i++) uc[out++] = digits[i];
+    uc[out++] = '.';
+    for (int i = point; i < count; i++) uc[out++] = digits[i];
+  } else if (-6 < point && point <= 0) {
+    // small fraction, leading zeros
+    uc[out++] = '0';
+    uc[out++] = '.';
+    for (int i = point; i < 0; i++) uc[out++] = '0';
+    for (int i = 0; i < count; i++) uc[out++] = digits[i];
+  } else {
+    // exponent
+    uc[out++] = digits[0];
+    if (count > 1) {
+      uc[out++] = '.';
+      for (int i = 1; i < count; i++) uc[out++] = digits[i];
+    }
+    uc[out++] = 'e';
+    uc[out++] = point > 0 ? '+' : '-';
+    int exponent = point > 0 ? point - 1 : 1 - point;
+    char exponentDigits[4];
+    int exponentCount = snprintf(
+        exponentDigits, sizeof(exponentDigits), "%d", exponent);
+    for (int i = 0; i < exponentCount; i++) uc[out++] = exponentDigits[i];
+  }
+
+  *ucLength = out;
+  return true;
+}
+
+bool decimalToWords(const SAP_UC* uc,
+                    uint_t length,
+                    int scale,
+                    bool* negative,
+                    std::vector<uint64_t>* words) {
+  // [sign] digits [. digits] [E [sign] digits]
+  std::string digits;
+  int point = -1;
+  uint_t i = 0;
+  *negative = false;
+  if (i < length && (uc[i] == '-' || uc[i] == '+')) {
+    *negative = uc[i++] == '-';
+  }
+  for (; i < length; i++) {
+    if (uc[i] >= '0' && uc[i] <= '9') {
+      digits += static_cast<char>(uc[i]);
+    } else if (uc[i] == '.' && point < 0) {
+      point = static_cast<int>(digits.size());
+    } else {
+      break;
+    }
+  }
+  if (digits.empty()) {
+    return false;
+  }
+  if (point < 0) {
+    point = static_cast<int>(digits.size());
+  }
+  if (i < length && (uc[i] == 'E' || uc[i] == 'e')) {
+    i++;
+    bool negativeExponent = false;
+    if (i < length && (uc[i] == '-' || uc[i] == '+')) {
+      negativeExponent = uc[i++] == '-';
+    }
+    int exponent = 0;
+    uint_t start = i;
+    for (; i < length && uc[i] >= '0' && uc[i] <= '9' && exponent < 100000;
+         i++) {
+      exponent = exponent * 10 + (uc[i] - '0');
+    }
+    if (i == start) {
+      return false;
+    }
+    point += negativeExponent ? -exponent : exponent;
+  }
+  if (i != length) {
+    return false;
+  }
+
+  // Integer digits of value * 10^scale, and the first dropped digit
+  int intDigits = point + scale;
+  char dropped = '0';
+  if (intDigits < static_cast<int>(digits.size())) {
+    if (intDigits >= 0) {
+      dropped = digits[intDigits];
+    }
+    digits.resize(intDigits > 0 ? intDigits : 0);
+  } else {
+    digits.append(intDigits - digits.size(), '0');
+  }
+
+  // Base 10^9 to base 2^32 limbs, least significant first
+  std::vector<uint32_t> limbs;
+  size_t first = digits.size() % 9;
+  if (first == 0) {
+    first = 9;
+  }
+  for (size_t pos = 0; pos < digits.size();) {
+    size_t end = pos + (pos == 0 ? first : 9);
+    uint64_t carry = 0;
+    for (; pos < end; pos++) {
+      carry = carry * 10 + (digits[pos] - '0');
+    }
+    uint64_t factor = end == first ? 1 : 1000000000;
+    for (uint32_t& limb : limbs) {
+      uint64_t product = limb * factor + carry;
+      limb = static_cast<uint32_t>(product);
+      carry = product >> 32;
+    }
+    if (carry != 0) {
+      limbs.push_back(static_cast<uint32_t>(carry));
+    }
+  }
+  if (dropped >= '5') {
+    uint64_t carry = 1;
+    for (uint32_t& limb : limbs) {
+      uint64_t sum = limb + carry;
+      limb = static_cast<uint32_t>(sum);
+      carry = sum >> 32;
+      if (carry == 0) {
+        break;
+      }
+    }
+    if (carry != 0) {
+      limbs.push_back(1);
+    }
+  }
+
+  words->assign((limbs.size() + 1) / 2, 0);
+  for (size_t l = 0; l < limbs.size(); l++) {
+    (*words)[l / 2] |= static_cast<uint64_t>(limbs[l]) << (32 * (l % 2));
+  }
+  if (words->empty()) {
+    // zero
+    words->push_back(0);
+    *negative = false;
+  }
+  return true;
+}
+
+std::string wordsToDecimal(bool negative,
+                           const uint64_t* words,
+                           size_t count,
+                           int scale) {
+  std::vector<uint32_t> limbs;
+  for (size_t w = 0; w < count; w++) {
+    limbs.push_back(static_cast<uint32_t>(words[w]));
+    limbs.push_back(static_cast<uint32_t>(words[w] >> 32));
+  }
+  while (!limbs.empty() && limbs.back() == 0) {
+    limbs.pop_back();
+  }
+
+  // Repeated division by 10^9, least significant digits first
+  std::string digits;
+  while (!limbs.empty()) {
+    uint64_t remainder = 0;
+    for (size_t l = limbs.size(); l > 0; l--) {
+      uint64_t current = (remainder << 32) | limbs[l - 1];
+      limbs[l - 1] = static_cast<uint32_t>(current / 1000000000);
+      remainder = current % 1000000000;
+    }
+    while (!limbs.empty() && limbs.back() == 0) {
+      limbs.pop_back();
+    }
+    for (int d = 0; d < 9 && (remainder != 0 || !limbs.empty()); d++) {
+      digits += static_cast<char>('0' + remainder % 10);
+      remainder /= 10;
+    }
+  }
+  bool zero = digits.empty();
+
+  // Decimal point after scale digits, from the right
+  if (scale > 0) {
+    if (digits.size() <= static_cast<size_t>(scale)) {
+      digits.append(scale + 1 - digits.size(), '0');
+    }
+    digits.insert(scale, 1, '.');
+  } else if (zero) {
+    digits = "0";
+  }
+  if (negative && !zero) {
+    digits += '-';
+  }
+  return std::string(digits.rbegin(), digits.rend());
+}
+
+}  // namespace node_rfc
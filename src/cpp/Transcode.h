@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef NodeRfc_Transcode_H
+#define NodeRfc_Transcode_H
+
+#include <string>
+#include <vector>
+#include "noderfc.h"
+
+namespace node_rfc {
+
+//
+// SAP unicode (UTF-16) <-> UTF-8 conversion fast paths, vectorized for ASCII.
+// No NodeJS or SAP NW RFC SDK API used, can run in worker thread.
+//
+
+// SAP unicode to UTF-8, trailing whitespaces trimmed. The utf8 buffer must
+// hold 3 bytes per unicode character. Returns false for surrogates, left to
+// RfcSAPUCToUTF8. Optional ascii is set when all characters are ASCII.
+bool transcodeToUtf8(const SAP_UC* uc,
+                     uint_t length,
+                     RFC_BYTE* utf8,
+                     uint_t* utf8Length,
+                     bool* ascii = nullptr);
+
+// ASCII UTF-8 to SAP unicode. The uc buffer must hold one unicode character
+// per byte. Returns false for non-ASCII input, left to RfcUTF8ToSAPUC.
+bool transcodeToSAPUC(const RFC_BYTE* utf8,
+                      uint_t length,
+                      SAP_UC* uc,
+                      uint_t* ucLength);
+
+//
+// ABAP decimal (BCD, DECF16, DECF34) <-> NodeJS Number conversion.
+//
+
+// Decimal digits, as returned by RfcGetString, to the nearest double, like
+// NodeJS Number(). Returns false for any other input.
+bool parseDecimal(const SAP_UC* uc, uint_t length, double* number);
+
+// Shortest digits which read back as the same double, formatted like NodeJS
+// Number.prototype.toString(). The uc buffer must hold 32 characters.
+// Returns false for NaN and Infinity.
+bool formatDecimal(double number, SAP_UC* uc, uint_t* ucLength);
+
+// Decimal digits, as returned by RfcGetString, multiplied by 10^scale and
+// rounded half away from zero, to BigInt magnitude words, least significant
+// word first. Returns false for any other input.
+bool decimalToWords(const SAP_UC* uc,
+                    uint_t length,
+                    int scale,
+                    bool* negative,
+                    std::vector<uint64_t>* words);
+
+// BigInt magnitude words divided by 10^scale to decimal digits
+std::string wordsToDecimal(bool negative,
+                           const uint64_t* words,
+                           size_t count,
+                           int scale);
+
+}  // namespace node_rfc
+
+#endif
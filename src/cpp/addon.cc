@@ -4,8 +4,11 @@
 
 #include "Client.h"
 #include "Log.h"
+#include "Metadata.h"
 #include "Pool.h"
 #include "Server.h"
+#include "TableCursor.h"
+#include "ThreadPool.h"
 #include "Throughput.h"
 
 namespace node_rfc {
@@ -129,8 +132,11 @@ Napi::Object RegisterModule(Napi::Env env, Napi::Object exports) {
   exports.Set("languageSapToIso", Napi::Function::New(env, LanguageSapToIso));
   exports.Set("reloadIniFile", Napi::Function::New(env, ReloadIniFile));
 
+  Metadata::Init(env, exports);
+  ThreadPool::Init(env, exports);
   Pool::Init(env, exports);
   Client::Init(env, exports);
+  TableCursor::Init(env, exports);
   Throughput::Init(env, exports);
   Server::Init(env, exports);
 
@@ -44,13 +44,34 @@
 #define CLIENT_OPTION_FILTER "filter"
 #define CLIENT_OPTION_STATELESS "stateless"
 #define CLIENT_OPTION_TIMEOUT "timeout"
+#define CLIENT_OPTION_TABLE "table"
+#define CLIENT_OPTION_DECODER "decoder"
+#define CLIENT_OPTION_BIGINT "bigint"
 
 #define CALL_OPTION_KEY_NOTREQUESTED "notRequested"
 #define CALL_OPTION_KEY_TIMEOUT CLIENT_OPTION_TIMEOUT
 
+#define BATCH_KEY_RFM "rfm"
+#define BATCH_KEY_PARAMS "params"
+#define BATCH_KEY_NOTREQUESTED CALL_OPTION_KEY_NOTREQUESTED
+#define BATCH_OPTION_CONCURRENCY "concurrency"
+
 #define CLIENT_OPTION_BCD_STRING 0
 #define CLIENT_OPTION_BCD_NUMBER 1
 #define CLIENT_OPTION_BCD_FUNCTION 2
+#define CLIENT_OPTION_BCD_SCALED_BIGINT 3
+#define CLIENT_OPTION_BCD_SCALE_MAX 34
+
+#define CLIENT_OPTION_TABLE_ROWS 0
+#define CLIENT_OPTION_TABLE_COLUMNS 1
+
+#define CLIENT_OPTION_DECODER_FIELD 0
+#define CLIENT_OPTION_DECODER_ROW 1
+
+#define CLIENT_OPTION_DATETIME_STRING 0
+#define CLIENT_OPTION_DATETIME_DATE 1
+#define CLIENT_OPTION_DATETIME_EPOCHMS 2
+#define CLIENT_OPTION_DATETIME_ISO 3
 
 //
 // Pool options constants
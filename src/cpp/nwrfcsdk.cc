@@ -5,6 +5,12 @@
 
 #include "nwrfcsdk.h"
 
+#include <cmath>
+#include <cstring>
+
+#include "Metadata.h"
+#include "Transcode.h"
+
 namespace node_rfc {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +28,12 @@ SAP_UC* setString(const Napi::String napistr) {
 
   SAP_UC* sapuc = new SAP_UC[sapucSize];
   memsetU(sapuc, 0, sapucSize);
+  if (transcodeToSAPUC(reinterpret_cast<const RFC_BYTE*>(sstr.data()),
+                       sapucSize - 1,
+                       sapuc,
+                       &resultLen)) {
+    return sapuc;
+  }
   rc = RfcUTF8ToSAPUC((RFC_BYTE*)&sstr[0],
                       sapucSize - 1,
                       sapuc,
@@ -56,6 +68,12 @@ SAP_UC* setString(std::string sstr) {
 
   SAP_UC* sapuc = new SAP_UC[sapucSize];
   memsetU(sapuc, 0, sapucSize);
+  if (transcodeToSAPUC(reinterpret_cast<const RFC_BYTE*>(sstr.data()),
+                       sapucSize - 1,
+                       sapuc,
+                       &resultLen)) {
+    return sapuc;
+  }
   rc = RfcUTF8ToSAPUC((RFC_BYTE*)&sstr[0],
                       sapucSize - 1,
                       sapuc,
@@ -82,322 +100,534 @@ SAP_UC* setString(std::string sstr) {
   return sapuc;
 }
 
-Napi::Value setRfmParameter(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
-                            RFC_FUNCTION_HANDLE functionHandle,
-                            Napi::String name,
-                            Napi::Value value,
-                            RfmErrorPath* errorPath,
-                            ClientOptionsStruct* client_options) {
-  Napi::EscapableHandleScope scope(value.Env());
-
-  RFC_RC rc;
+Napi::Value ImportColumns::init(const BindingPlan* typePlan,
+                                Napi::Object value,
+                                RfmErrorPath* errorPath) {
   RFC_ERROR_INFO errorInfo;
-  RFC_PARAMETER_DESC paramDesc;
-  SAP_UC* cName = setString(name);
-  errorPath->setParameterName(cName);
-  rc = RfcGetParameterDescByName(
-      functionDescHandle, cName, &paramDesc, &errorInfo);
-  delete[] cName;
-  if (rc != RFC_OK) {
-    return scope.Escape(rfcSdkError(&errorInfo, errorPath));
-  }
-  return scope.Escape(setVariable(paramDesc.type,
-                                  functionHandle,
-                                  paramDesc.name,
-                                  value,
-                                  paramDesc.typeDescHandle,
-                                  errorPath,
-                                  client_options));
-}
-
-Napi::Value setStructure(RFC_STRUCTURE_HANDLE structHandle,
-                         RFC_TYPE_DESC_HANDLE functionDescHandle,
-                         Napi::Value value,
-                         RfmErrorPath* errorPath,
-                         ClientOptionsStruct* client_options) {
-  RFC_RC rc;
-  RFC_ERROR_INFO errorInfo;
-
-  Napi::EscapableHandleScope scope(value.Env());
 
-  Napi::Object structObj = value.ToObject();
-  Napi::Array structNames = structObj.GetPropertyNames();
-  uint_t structSize = structNames.Length();
+  Napi::Array names = value.GetPropertyNames();
+  uint_t columnCount = names.Length();
+  columns.resize(columnCount);
+  rowCount = 0;
+
+  for (uint_t i = 0; i < columnCount; i++) {
+    Napi::String name = names.Get(i).ToString();
+    ImportColumn& column = columns[i];
+    column.binding = typePlan->find(name.Utf8Value(), &errorInfo);
+    if (column.binding == nullptr) {
+      SAP_UC* cName = setString(name);
+      errorPath->setFieldName(cName);
+      delete[] cName;
+      return rfcSdkError(&errorInfo, errorPath);
+    }
+    errorPath->setFieldName(column.binding->name);
+    column.column = value.Get(name);
+    column.data = nullptr;
+    column.width = 0;
+
+    uint_t length;
+    if (column.column.IsTypedArray()) {
+      Napi::TypedArray typedArray = column.column.As<Napi::TypedArray>();
+      column.type = typedArray.TypedArrayType();
+      column.data =
+          static_cast<const uint8_t*>(typedArray.ArrayBuffer().Data()) +
+          typedArray.ByteOffset();
+      length = typedArray.ElementLength();
+      switch (column.binding->type) {
+        case RFCTYPE_BYTE:
+        case RFCTYPE_CHAR:
+        case RFCTYPE_NUM:
+        case RFCTYPE_DATE:
+        case RFCTYPE_TIME:
+          if (column.type != napi_uint8_array) {
+            break;
+          }
+          column.width = column.binding->nucLength;
+          if (column.width == 0 || length % column.width != 0) {
+            return nodeRfcError(
+                "Buffer of " + std::to_string(column.width) +
+                    " bytes per row expected from NodeJS, for ABAP table "
+                    "column of type " +
+                    std::to_string(column.binding->type),
+                errorPath);
+          }
+          length /= column.width;
+          if (column.binding->type != RFCTYPE_BYTE) {
+            // Char-like values copied as they are, one byte per character
+            for (uint_t b = 0; b < typedArray.ElementLength(); b++) {
+              if (column.data[b] & 0x80) {
+                errorPath->table_line = b / column.width;
+                return nodeRfcError(
+                    "ASCII Buffer expected from NodeJS, for ABAP table "
+                    "column of type " +
+                        std::to_string(column.binding->type),
+                    errorPath);
+              }
+            }
+          }
+          break;
+        default:
+          break;
+      }
+    } else if (column.column.IsArray()) {
+      length = column.column.As<Napi::Array>().Length();
+    } else {
+      return nodeRfcError(
+          "Array, typed array or Buffer expected from NodeJS, for ABAP "
+          "table column of type " +
+              std::to_string(column.binding->type),
+          errorPath);
+    }
 
-  RFC_FIELD_DESC fieldDesc;
+    if (i == 0) {
+      rowCount = length;
+    } else if (length != rowCount) {
+      return nodeRfcError(
+          "Table columns of equal length expected from NodeJS, got " +
+              std::to_string(length) + " instead of " +
+              std::to_string(rowCount),
+          errorPath);
+    }
+  }
+  return value.Env().Undefined();
+}
 
-  Napi::Value retVal = value.Env().Undefined();
+double ImportColumns::number(const ImportColumn& column, uint_t row) {
+  switch (column.type) {
+    case napi_int8_array:
+      return reinterpret_cast<const int8_t*>(column.data)[row];
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return column.data[row];
+    case napi_int16_array:
+      return reinterpret_cast<const int16_t*>(column.data)[row];
+    case napi_uint16_array:
+      return reinterpret_cast<const uint16_t*>(column.data)[row];
+    case napi_int32_array:
+      return reinterpret_cast<const int32_t*>(column.data)[row];
+    case napi_uint32_array:
+      return reinterpret_cast<const uint32_t*>(column.data)[row];
+    case napi_float32_array:
+      return reinterpret_cast<const float*>(column.data)[row];
+    case napi_bigint64_array:
+      return static_cast<double>(
+          reinterpret_cast<const int64_t*>(column.data)[row]);
+    case napi_biguint64_array:
+      return static_cast<double>(
+          reinterpret_cast<const uint64_t*>(column.data)[row]);
+    default:
+      // napi_float64_array
+      return reinterpret_cast<const double*>(column.data)[row];
+  }
+}
 
-  for (uint_t i = 0; i < structSize; i++) {
-    Napi::String name = structNames.Get(i).ToString();
-    Napi::Value _value = structObj.Get(name);
+Napi::Value ImportColumns::get(const ImportColumn& column, uint_t row) const {
+  if (column.data == nullptr) {
+    return column.column.As<Napi::Array>().Get(row);
+  }
+  if (column.type == napi_bigint64_array) {
+    return Napi::BigInt::New(
+        node_rfc::__env, reinterpret_cast<const int64_t*>(column.data)[row]);
+  }
+  if (column.type == napi_biguint64_array) {
+    return Napi::BigInt::New(
+        node_rfc::__env, reinterpret_cast<const uint64_t*>(column.data)[row]);
+  }
+  return Napi::Number::New(node_rfc::__env, number(column, row));
+}
 
-    SAP_UC* cValue = setString(name);
-    rc = RfcGetFieldDescByName(
-        functionDescHandle, cValue, &fieldDesc, &errorInfo);
-    delete[] cValue;
-    if (rc != RFC_OK) {
-      errorPath->setFieldName(fieldDesc.name);
-      retVal = rfcSdkError(&errorInfo, errorPath);
-      break;
+Napi::Value toInteger(RFCTYPE typ,
+                      Napi::Value value,
+                      int64_t* integer,
+                      RfmErrorPath* errorPath) {
+  if (value.IsBigInt()) {
+    bool lossless;
+    *integer = value.As<Napi::BigInt>().Int64Value(&lossless);
+    if (!lossless) {
+      return nodeRfcError(
+          "Overflow or other error when putting NodeJS value " +
+              value.ToString().Utf8Value() +
+              " into ABAP integer field of type " + std::to_string(typ),
+          errorPath);
     }
-    retVal = setVariable(fieldDesc.type,
-                         structHandle,
-                         fieldDesc.name,
-                         _value,
-                         fieldDesc.typeDescHandle,
-                         errorPath,
-                         client_options);
-    if (!retVal.IsUndefined()) {
-      break;
+  } else if (value.IsNumber()) {
+    // https://github.com/mhdawson/node-sqlite3/pull/3
+    double number = value.As<Napi::Number>().DoubleValue();
+    if (!(number >= -9223372036854775808.0 && number < 9223372036854775808.0) ||
+        (int64_t)number != number) {
+      return nodeRfcError(
+          "Integer number expected from NodeJS for ABAP field of type " +
+              std::to_string(typ) + ", got " + value.ToString().Utf8Value(),
+          errorPath);
     }
+    *integer = (int64_t)number;
+  } else {
+    return nodeRfcError(
+        "Integer number expected from NodeJS for ABAP field of type " +
+            std::to_string(typ),
+        errorPath);
   }
-  return retVal;
+  return checkInteger(typ, *integer, errorPath);
 }
 
-Napi::Value setVariable(RFCTYPE typ,
-                        RFC_FUNCTION_HANDLE functionHandle,
-                        SAP_UC* cName,
-                        Napi::Value value,
-                        RFC_TYPE_DESC_HANDLE functionDescHandle,
-                        RfmErrorPath* errorPath,
-                        ClientOptionsStruct* client_options) {
-  Napi::EscapableHandleScope scope(value.Env());
-  RFC_RC rc = RFC_OK;
-  RFC_ERROR_INFO errorInfo;
-  SAP_UC* cValue;
+bool integerInRange(RFCTYPE typ, int64_t integer) {
+  switch (typ) {
+    case RFCTYPE_INT1:
+      return integer >= 0 && integer <= UINT8_MAX;
+    case RFCTYPE_INT2:
+      return integer >= INT16_MIN && integer <= INT16_MAX;
+    case RFCTYPE_INT:
+      return integer >= INT32_MIN && integer <= INT32_MAX;
+    default:
+      return true;
+  }
+}
 
-  errorPath->setName(typ, cName);
+Napi::Value checkInteger(RFCTYPE typ,
+                         int64_t integer,
+                         RfmErrorPath* errorPath) {
+  if (!integerInRange(typ, integer)) {
+    return nodeRfcError(
+        "Overflow or other error when putting NodeJS value " +
+            std::to_string(integer) + " into ABAP integer field of type " +
+            std::to_string(typ),
+        errorPath);
+  }
+  return node_rfc::__env.Undefined();
+}
 
-  switch (typ) {
-    case RFCTYPE_STRUCTURE: {
-      RFC_STRUCTURE_HANDLE structHandle;
-      rc = RfcGetStructure(functionHandle, cName, &structHandle, &errorInfo);
-      if (rc != RFC_OK) {
-        return scope.Escape(rfcSdkError(&errorInfo, errorPath));
-      }
-      Napi::Value rv = setStructure(
-          structHandle, functionDescHandle, value, errorPath, client_options);
-      if (!rv.IsUndefined()) {
-        return scope.Escape(rv);
-      }
-      break;
-    }
-    case RFCTYPE_TABLE: {
-      RFC_TABLE_HANDLE tableHandle;
-      rc = RfcGetTable(functionHandle, cName, &tableHandle, &errorInfo);
+////////////////////////////////////////////////////////////////////////////////
+// Get Parameters (from SDK)
+////////////////////////////////////////////////////////////////////////////////
 
-      if (rc != RFC_OK) {
-        break;
-      }
-      if (!value.IsArray()) {
-        return nodeRfcError(
-            "Array expected from NodeJS, for ABAP RFM table of type " +
-                std::to_string(typ),
-            errorPath);
-      }
-      Napi::Array array = value.As<Napi::Array>();
-      uint_t rowCount = array.Length();
+Napi::String newString(const char* utf8, size_t length, bool ascii) {
+  if (!ascii) {
+    return Napi::String::New(node_rfc::__env, utf8, length);
+  }
+  // ASCII is valid Latin-1, V8 skips UTF-8 decoding
+  napi_value result;
+  if (napi_create_string_latin1(node_rfc::__env, utf8, length, &result) !=
+      napi_ok) {
+    return Napi::String::New(node_rfc::__env, utf8, length);
+  }
+  return Napi::String(node_rfc::__env, result);
+}
 
-      for (uint_t i = 0; i < rowCount; i++) {
-        errorPath->table_line = i;
-        RFC_STRUCTURE_HANDLE structHandle =
-            RfcAppendNewRow(tableHandle, &errorInfo);
-        Napi::Value line = array.Get(i);
-        if (line.IsBuffer() || line.IsString() || line.IsNumber()) {
-          Napi::Object lineObj = Napi::Object::New(value.Env());
-          lineObj.Set(Napi::String::New(value.Env(), ""), line);
-          line = lineObj;
-        }
-        Napi::Value rv = setStructure(
-            structHandle, functionDescHandle, line, errorPath, client_options);
-        if (!rv.IsUndefined()) {
-          return scope.Escape(rv);
-        }
-      }
-      break;
-    }
-    case RFCTYPE_BYTE: {
-      if (!value.IsBuffer()) {
-        return nodeRfcError(
-            "Buffer expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
+Napi::Object newObject(const napi_property_descriptor* properties,
+                       size_t count) {
+  Napi::Object object = Napi::Object::New(node_rfc::__env);
+  if (napi_define_properties(node_rfc::__env, object, count, properties) !=
+      napi_ok) {
+    throw Napi::Error::New(node_rfc::__env);
+  }
+  return object;
+}
 
-      Napi::Buffer<SAP_RAW> js_buf = value.As<Napi::Buffer<SAP_RAW>>();
-      uint_t js_buf_bytelen = js_buf.ByteLength();
-      SAP_RAW* byteValue = new SAP_RAW[js_buf_bytelen];
-      memcpy(byteValue, js_buf.Data(), js_buf_bytelen);
+static const double MS_PER_DAY = 86400000.0;
+
+// Days since 1970-01-01 of proleptic Gregorian calendar date, see
+// http://howardhinnant.github.io/date_algorithms.html
+static int64_t daysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t yoe = year - era * 400;
+  int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
 
-      // excessive padding bytes sent from NodeJS, are silently trimmed by SDK
-      // to ABAP field length
-      rc = RfcSetBytes(
-          functionHandle, cName, byteValue, js_buf_bytelen, &errorInfo);
-      delete[] byteValue;
-      break;
+static void civilFromDays(int64_t days,
+                          int64_t* year,
+                          int64_t* month,
+                          int64_t* day) {
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t doe = days - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t mp = (5 * doy + 2) / 153;
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = yoe + era * 400 + (*month <= 2);
+}
+
+// Value of count ASCII digits, -1 for any other char
+static int getDigits(const char* chars, uint_t count) {
+  int value = 0;
+  for (uint_t i = 0; i < count; i++) {
+    if (chars[i] < '0' || chars[i] > '9') {
+      return -1;
     }
-    case RFCTYPE_XSTRING: {
-      if (!value.IsBuffer()) {
-        return nodeRfcError(
-            "Buffer expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
+    value = value * 10 + (chars[i] - '0');
+  }
+  return value;
+}
 
-      Napi::Buffer<SAP_RAW> js_buf = value.As<Napi::Buffer<SAP_RAW>>();
-      uint_t js_buf_bytelen = js_buf.ByteLength();
-      SAP_RAW* byteValue = new SAP_RAW[js_buf_bytelen];
-      memcpy(byteValue, js_buf.Data(), js_buf_bytelen);
+static void putDigits(char* chars, int64_t value, uint_t count) {
+  for (uint_t i = count; i > 0; i--) {
+    chars[i - 1] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+}
 
-      rc = RfcSetXString(
-          functionHandle, cName, byteValue, js_buf_bytelen, &errorInfo);
-      delete[] byteValue;
-      break;
-    }
-    case RFCTYPE_CHAR:
-    case RFCTYPE_STRING: {
-      if (!value.IsString()) {
-        return nodeRfcError(
-            "String expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc = RfcSetString(
-          functionHandle, cName, cValue, strlenU(cValue), &errorInfo);
-      delete[] cValue;
-      break;
-    }
-    case RFCTYPE_NUM: {
-      if (!value.IsString()) {
-        return nodeRfcError(
-            "Char expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc =
-          RfcSetNum(functionHandle, cName, cValue, strlenU(cValue), &errorInfo);
-      delete[] cValue;
-      break;
-    }
-    case RFCTYPE_BCD:  // fallthrough
-    case RFCTYPE_DECF16:
-    case RFCTYPE_DECF34:
-    case RFCTYPE_FLOAT: {
-      if (!value.IsNumber() && !value.IsObject() && !value.IsString()) {
-        return nodeRfcError("Number, number object or string expected from "
-                            "NodeJS for ABAP field of type " +
-                                std::to_string(typ),
-                            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc = RfcSetString(
-          functionHandle, cName, cValue, strlenU(cValue), &errorInfo);
-      delete[] cValue;
-      break;
-    }
-    case RFCTYPE_INT:  // fallthrough
-    case RFCTYPE_INT1:
-    case RFCTYPE_INT2:
-    case RFCTYPE_INT8: {
-      if (!value.IsNumber()) {
-        return nodeRfcError(
-            "Integer number expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
+static bool validDate(int year, int month, int day) {
+  static const int monthDays[] = {
+      31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if (year < 1 || month < 1 || month > 12 || day < 1 ||
+      day > monthDays[month - 1]) {
+    return false;
+  }
+  bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  return month != 2 || day < 29 || leap;
+}
 
-      // https://github.com/mhdawson/node-sqlite3/pull/3
-      double numDouble = value.ToNumber().DoubleValue();
-      if ((int64_t)numDouble !=
-          numDouble)  // or std::trunc(numDouble) == numDouble;
-      {
-        return nodeRfcError(
-            "Integer number expected from NodeJS for ABAP field of type " +
-                std::to_string(typ) + ", got " + value.ToString().Utf8Value(),
-            errorPath);
-      }
-      RFC_INT rfcInt = (RFC_INT)value.As<Napi::Number>().Int64Value();
-      // int64_t rfcInt = value.As<Napi::Number>().Int64Value();
-      // printf("typ: %d value: %d %u", typ, rfcInt, UINT8_MAX);
-      if (typ == RFCTYPE_INT8) {
-        rc = RfcSetInt8(functionHandle, cName, rfcInt, &errorInfo);
-      } else {
-        if ((typ == RFCTYPE_INT1 && rfcInt > UINT8_MAX) ||
-            (typ == RFCTYPE_INT2 &&
-             ((rfcInt > INT16_MAX) || (rfcInt < INT16_MIN)))) {
-          return nodeRfcError(
-              "Overflow or other error when putting NodeJS value " +
-                  std::to_string(rfcInt) + " into ABAP integer field of type " +
-                  std::to_string(typ),
-              errorPath);
-        }
+// Copies ABAP date or time string, ISO separators removed
+static bool unwrapString(Napi::Value value,
+                         uint_t length,
+                         char separator,
+                         char* chars) {
+  std::string str = value.As<Napi::String>().Utf8Value();
+  if (str.size() == length) {
+    memcpy(chars, str.data(), length);
+    return true;
+  }
+  if (str.size() != length + 2) {
+    return false;
+  }
+  // YYYY-MM-DD or HH:MM:SS
+  uint_t first = length == 8 ? 4 : 2;
+  if (str[first] != separator || str[first + 3] != separator) {
+    return false;
+  }
+  memcpy(chars, str.data(), first);
+  memcpy(chars + first, str.data() + first + 1, 2);
+  memcpy(chars + first + 2, str.data() + first + 4, length - first - 2);
+  return getDigits(chars, length) >= 0;
+}
 
-        rc = RfcSetInt(functionHandle, cName, rfcInt, &errorInfo);
-      }
-      break;
-    }
-    case RFCTYPE_UTCLONG: {
-      if (!value.IsString()) {
-        return nodeRfcError(
-            "UTCLONG string expected from NodeJS for ABAP field of type " +
-                std::to_string(typ),
-            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc = RfcSetString(
-          functionHandle, cName, cValue, strlenU(cValue), &errorInfo);
-      delete[] cValue;
-      break;
-    }
-    case RFCTYPE_DATE: {
-      if (!client_options->dateToABAP.IsEmpty()) {
-        // YYYYMMDD format expected
-        value = client_options->dateToABAP.Call({value});
-      }
-      if (!value.IsString()) {
-        return nodeRfcError("Date format YYYYMMDD expected from NodeJS "
-                            "for ABAP field of type " +
-                                std::to_string(typ),
-                            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc = RfcSetDate(functionHandle, cName, cValue, &errorInfo);
-      delete[] cValue;
-      break;
-    }
-    case RFCTYPE_TIME: {
-      if (!client_options->timeToABAP.IsEmpty()) {
-        // HHMMSS format expected
-        value = client_options->timeToABAP.Call({value});
-      }
-      if (!value.IsString()) {
-        return nodeRfcError("Time format HHMMSS expected from NodeJS for "
-                            "ABAP field of type " +
-                                std::to_string(typ),
-                            errorPath);
-      }
-      cValue = setString(value.ToString());
-      rc = RfcSetTime(functionHandle, cName, cValue, &errorInfo);
-      delete[] cValue;
-      break;
+const char* dateTimePresetName(uint_t preset) {
+  switch (preset) {
+    case CLIENT_OPTION_DATETIME_DATE:
+      return "Date";
+    case CLIENT_OPTION_DATETIME_EPOCHMS:
+      return "epochMs";
+    case CLIENT_OPTION_DATETIME_ISO:
+      return "iso";
+    default:
+      return "string";
+  }
+}
+
+Napi::Value wrapDate(const char* date, uint_t preset) {
+  int year = getDigits(date, 4);
+  int month = getDigits(date + 4, 2);
+  int day = getDigits(date + 6, 2);
+  if (!validDate(year, month, day)) {
+    return node_rfc::__env.Null();
+  }
+  switch (preset) {
+    case CLIENT_OPTION_DATETIME_ISO: {
+      char iso[10] = {date[0], date[1], date[2], date[3], '-',
+                      date[4], date[5], '-',     date[6], date[7]};
+      return newString(iso, 10, true);
     }
-    default: {
-      return nodeRfcError("Unknown RFC type from NodeJS " + std::to_string(typ),
-                          errorPath);
+    case CLIENT_OPTION_DATETIME_EPOCHMS:
+      return Napi::Number::New(node_rfc::__env,
+                               daysFromCivil(year, month, day) * MS_PER_DAY);
+    default:
+      return Napi::Date::New(node_rfc::__env,
+                             daysFromCivil(year, month, day) * MS_PER_DAY);
+  }
+}
+
+Napi::Value wrapTime(const char* time, uint_t preset) {
+  int hour = getDigits(time, 2);
+  int minute = getDigits(time + 2, 2);
+  int second = getDigits(time + 4, 2);
+  if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 ||
+      second > 59) {
+    return node_rfc::__env.Null();
+  }
+  switch (preset) {
+    case CLIENT_OPTION_DATETIME_ISO: {
+      char iso[8] = {
+          time[0], time[1], ':', time[2], time[3], ':', time[4], time[5]};
+      return newString(iso, 8, true);
     }
+    case CLIENT_OPTION_DATETIME_EPOCHMS:
+      return Napi::Number::New(node_rfc::__env,
+                               (hour * 3600 + minute * 60 + second) * 1000.0);
+    default:
+      return Napi::Date::New(node_rfc::__env,
+                             (hour * 3600 + minute * 60 + second) * 1000.0);
   }
-  if (rc != RFC_OK) {
-    return scope.Escape(rfcSdkError(&errorInfo, errorPath));
+}
+
+Napi::Value wrapDate(const SAP_UC* date, uint_t preset) {
+  char chars[8];
+  for (uint_t i = 0; i < 8; i++) {
+    chars[i] = date[i] < 0x80 ? static_cast<char>(date[i]) : '?';
   }
-  return scope.Env().Undefined();
+  return wrapDate(chars, preset);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Get Parameters (from SDK)
-////////////////////////////////////////////////////////////////////////////////
+Napi::Value wrapTime(const SAP_UC* time, uint_t preset) {
+  char chars[6];
+  for (uint_t i = 0; i < 6; i++) {
+    chars[i] = time[i] < 0x80 ? static_cast<char>(time[i]) : '?';
+  }
+  return wrapTime(chars, preset);
+}
+
+bool unwrapDate(Napi::Value value, uint_t preset, char* date) {
+  if (value.IsString()) {
+    return unwrapString(value, 8, '-', date);
+  }
+  if (value.IsNull()) {
+    memset(date, '0', 8);
+    return true;
+  }
+  double ms;
+  if (preset == CLIENT_OPTION_DATETIME_DATE && value.IsDate()) {
+    ms = value.As<Napi::Date>().ValueOf();
+  } else if (preset == CLIENT_OPTION_DATETIME_EPOCHMS && value.IsNumber()) {
+    ms = value.As<Napi::Number>().DoubleValue();
+  } else {
+    return false;
+  }
+  if (!std::isfinite(ms)) {
+    return false;
+  }
+  int64_t year, month, day;
+  civilFromDays(
+      static_cast<int64_t>(std::floor(ms / MS_PER_DAY)), &year, &month, &day);
+  if (year < 1 || year > 9999) {
+    return false;
+  }
+  putDigits(date, year, 4);
+  putDigits(date + 4, month, 2);
+  putDigits(date + 6, day, 2);
+  return true;
+}
+
+bool unwrapTime(Napi::Value value, uint_t preset, char* time) {
+  if (value.IsString()) {
+    return unwrapString(value, 6, ':', time);
+  }
+  if (value.IsNull()) {
+    memset(time, '0', 6);
+    return true;
+  }
+  double ms;
+  if (preset == CLIENT_OPTION_DATETIME_DATE && value.IsDate()) {
+    ms = value.As<Napi::Date>().ValueOf();
+  } else if (preset == CLIENT_OPTION_DATETIME_EPOCHMS && value.IsNumber()) {
+    ms = value.As<Napi::Number>().DoubleValue();
+  } else {
+    return false;
+  }
+  if (!std::isfinite(ms)) {
+    return false;
+  }
+  // Time of day, in UTC for Date
+  int64_t seconds = static_cast<int64_t>(
+      std::floor((ms - std::floor(ms / MS_PER_DAY) * MS_PER_DAY) / 1000));
+  putDigits(time, seconds / 3600, 2);
+  putDigits(time + 2, seconds / 60 % 60, 2);
+  putDigits(time + 4, seconds % 60, 2);
+  return true;
+}
+
+Napi::Value wrapScaledDecimal(const SAP_UC* uc, uint_t length, int scale) {
+  bool negative;
+  std::vector<uint64_t> words;
+  if (!decimalToWords(uc, length, scale, &negative, &words)) {
+    return Napi::Value();
+  }
+  return Napi::BigInt::New(
+      node_rfc::__env, negative ? 1 : 0, words.size(), words.data());
+}
+
+std::string unwrapScaledDecimal(Napi::BigInt value, int scale) {
+  int sign;
+  size_t count = value.WordCount();
+  std::vector<uint64_t> words(count);
+  value.ToWords(&sign, &count, words.data());
+  return wordsToDecimal(sign != 0, words.data(), count, scale);
+}
+
+bool appendUtf8(const SAP_UC* uc,
+                uint_t length,
+                std::string* utf8,
+                bool* ascii) {
+  RFC_ERROR_INFO errorInfo;
+
+  if (ascii != nullptr) {
+    *ascii = true;
+  }
+  if (length == 0) {
+    return true;
+  }
+  size_t start = utf8->size();
+  // try with 3 bytes per unicode character
+  uint_t utf8Size = length * 3;
+  uint_t resultLen = 0;
+  utf8->resize(start + utf8Size + 1);
+  if (transcodeToUtf8(uc,
+                      length,
+                      reinterpret_cast<RFC_BYTE*>(&(*utf8)[start]),
+                      &resultLen,
+                      ascii)) {
+    utf8->resize(start + resultLen);
+    return true;
+  }
+  // surrogates, converted by SDK
+  if (ascii != nullptr) {
+    *ascii = false;
+  }
+  RfcSAPUCToUTF8(uc,
+                 length,
+                 reinterpret_cast<RFC_BYTE*>(&(*utf8)[start]),
+                 &utf8Size,
+                 &resultLen,
+                 &errorInfo);
+  _log.record(logClass::nwrfc,
+              logLevel::all,
+              "wrapString len: ",
+              length,
+              " utf8Size: ",
+              utf8Size,
+              " resultLen: ",
+              resultLen,
+              " Error group:",
+              errorInfo.group,
+              " code: ",
+              errorInfo.code);
+  if (errorInfo.code != RFC_OK) {
+    // not enough, try with 5
+    utf8Size = length * 5;
+    resultLen = 0;
+    utf8->resize(start + utf8Size + 1);
+    RfcSAPUCToUTF8(uc,
+                   length,
+                   reinterpret_cast<RFC_BYTE*>(&(*utf8)[start]),
+                   &utf8Size,
+                   &resultLen,
+                   &errorInfo);
+    if (errorInfo.code != RFC_OK) {
+      utf8->resize(start);
+      return false;
+    }
+  }
+
+  // trim trailing whitespaces
+  while (resultLen > 0 &&
+         isspace(static_cast<unsigned char>((*utf8)[start + resultLen - 1]))) {
+    resultLen--;
+  }
+  utf8->resize(start + resultLen);
+  return true;
+}
 
 Napi::Value wrapString(const SAP_UC* uc, int length) {
   RFC_ERROR_INFO errorInfo;
@@ -410,11 +640,17 @@ Napi::Value wrapString(const SAP_UC* uc, int length) {
   if (length == 0) {
     return scope.Escape(Napi::String::New(node_rfc::__env, ""));
   }
+  ArenaScope arena;
   // try with 3 bytes per unicode character
   uint_t utf8Size = length * 3;
-  RFC_BYTE* utf8 = new RFC_BYTE[utf8Size + 1];
-  utf8[0] = '\0';
+  RFC_BYTE* utf8 = arena.alloc<RFC_BYTE>(utf8Size + 1);
   uint_t resultLen = 0;
+  bool ascii;
+  if (transcodeToUtf8(uc, length, utf8, &resultLen, &ascii)) {
+    return scope.Escape(
+        newString(reinterpret_cast<char*>(utf8), resultLen, ascii));
+  }
+  // surrogates, converted by SDK
   RfcSAPUCToUTF8(uc, length, utf8, &utf8Size, &resultLen, &errorInfo);
   _log.record(logClass::nwrfc,
               logLevel::all,
@@ -430,28 +666,21 @@ Napi::Value wrapString(const SAP_UC* uc, int length) {
               errorInfo.code);
   if (errorInfo.code != RFC_OK) {
     // not enough, try with 5
-    delete[] utf8;
     utf8Size = length * 5;
-    utf8 = new RFC_BYTE[utf8Size + 1];
-    utf8[0] = '\0';
+    utf8 = arena.alloc<RFC_BYTE>(utf8Size + 1);
     resultLen = 0;
     RfcSAPUCToUTF8(uc, length, utf8, &utf8Size, &resultLen, &errorInfo);
     if (errorInfo.code != RFC_OK) {
-      delete[] utf8;
       return node_rfc::__env.Undefined();
     }
   }
 
   // trim trailing whitespaces
-  int i = resultLen - 1;
-  while (i >= 0 && isspace(utf8[i])) {
-    i--;
-  }
-  utf8[i + 1] = '\0';
-  Napi::Value resultValue = Napi::String::New(
-      node_rfc::__env, std::string(reinterpret_cast<char*>(utf8), i + 1));
-  delete[] utf8;
-  return scope.Escape(resultValue);
+  while (resultLen > 0 && isspace(utf8[resultLen - 1])) {
+    resultLen--;
+  }
+  return scope.Escape(Napi::String::New(
+      node_rfc::__env, reinterpret_cast<char*>(utf8), resultLen));
 }
 
 ValuePair getRfmParameters(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
@@ -480,6 +709,7 @@ ValuePair getRfmParameters(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
                                      functionHandle,
                                      paramDesc.name,
                                      paramDesc.nucLength,
+                                     paramDesc.decimals,
                                      paramDesc.typeDescHandle,
                                      errorPath,
                                      client_options);
@@ -492,57 +722,343 @@ ValuePair getRfmParameters(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
   return ValuePair(ENV_UNDEFINED, scope.Escape(resultObj));
 }
 
-ValuePair getStructure(RFC_TYPE_DESC_HANDLE typeDesc,
-                       RFC_STRUCTURE_HANDLE structHandle,
-                       RfmErrorPath* errorPath,
-                       ClientOptionsStruct* client_options) {
-  Napi::EscapableHandleScope scope(node_rfc::__env);
+Napi::Value FieldKeys::get(RFC_TYPE_DESC_HANDLE typeDescHandle,
+                           uint_t fieldCount,
+                           uint_t index,
+                           const SAP_UC* name) {
+  std::vector<Napi::Reference<Napi::Value>>& typeKeys = keys[typeDescHandle];
+  if (typeKeys.empty()) {
+    typeKeys.resize(fieldCount);
+  }
+  if (typeKeys[index].IsEmpty()) {
+    typeKeys[index] = Napi::Persistent(wrapString(name));
+  }
+  return typeKeys[index].Value();
+}
 
-  Napi::Object resultObj = Napi::Object::New(node_rfc::__env);
+// Field name key, reused when the caller keeps the keys
+static Napi::Value fieldKey(FieldKeys* fieldKeys,
+                            const BindingPlan* typePlan,
+                            uint_t index) {
+  const FieldBinding& field = typePlan->fields[index];
+  if (fieldKeys == nullptr) {
+    return wrapString(field.name);
+  }
+  return fieldKeys->get(
+      typePlan->typeDescHandle, typePlan->fields.size(), index, field.name);
+}
 
-  RFC_RC rc;
+// Flat structure decoded in one pass over the cached field layout. Char-like
+// structure is read at once into the row buffer and sliced by field offsets,
+// other fields are read by index, without name lookups.
+static ValuePair getFlatStructure(const BindingPlan* typePlan,
+                                  RFC_STRUCTURE_HANDLE structHandle,
+                                  RfmErrorPath* errorPath,
+                                  ClientOptionsStruct* client_options,
+                                  FieldKeys* fieldKeys) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  RFC_RC rc = RFC_OK;
   RFC_ERROR_INFO errorInfo;
-  RFC_FIELD_DESC fieldDesc;
-  uint_t fieldCount;
-  rc = RfcGetFieldCount(typeDesc, &fieldCount, &errorInfo);
-  if (rc != RFC_OK) {
-    return ValuePair(rfcSdkError(&errorInfo, errorPath), ENV_UNDEFINED);
+  uint_t fieldCount = typePlan->fields.size();
+  ArenaScope arena;
+  napi_property_descriptor* properties =
+      arena.alloc<napi_property_descriptor>(fieldCount);
+  RFC_BYTE* row = arena.alloc<RFC_BYTE>(typePlan->ucLength);
+
+  if (typePlan->charLike) {
+    rc = RfcGetStructureIntoCharBuffer(structHandle,
+                                       reinterpret_cast<SAP_UC*>(row),
+                                       typePlan->ucLength / sizeof(SAP_UC),
+                                       &errorInfo);
+    if (rc != RFC_OK) {
+      return ValuePair(rfcSdkError(&errorInfo, errorPath), ENV_UNDEFINED);
+    }
   }
 
   for (uint_t i = 0; i < fieldCount; i++) {
-    rc = RfcGetFieldDescByIndex(typeDesc, i, &fieldDesc, &errorInfo);
+    const FieldBinding& field = typePlan->fields[i];
+    SAP_UC* chars = reinterpret_cast<SAP_UC*>(row + field.ucOffset);
+    Napi::Value value;
+    switch (field.type) {
+      case RFCTYPE_CHAR:
+        if (!typePlan->charLike) {
+          rc = RfcGetCharsByIndex(
+              structHandle, field.index, chars, field.nucLength, &errorInfo);
+        }
+        value = wrapString(chars, field.nucLength);
+        break;
+      case RFCTYPE_NUM:
+        if (!typePlan->charLike) {
+          rc = RfcGetNumByIndex(
+              structHandle, field.index, chars, field.nucLength, &errorInfo);
+        }
+        value = wrapString(chars, field.nucLength);
+        break;
+      case RFCTYPE_DATE:
+        if (!typePlan->charLike) {
+          rc = RfcGetDateByIndex(structHandle, field.index, chars, &errorInfo);
+        }
+        if (rc != RFC_OK) {
+          break;
+        }
+        if (client_options->datePreset != CLIENT_OPTION_DATETIME_STRING) {
+          value = wrapDate(chars, client_options->datePreset);
+          break;
+        }
+        value = wrapString(chars, 8);
+        if (!client_options->dateFromABAP.IsEmpty()) {
+          value = client_options->dateFromABAP.Call({value});
+        }
+        break;
+      case RFCTYPE_TIME:
+        if (!typePlan->charLike) {
+          rc = RfcGetTimeByIndex(structHandle, field.index, chars, &errorInfo);
+        }
+        if (rc != RFC_OK) {
+          break;
+        }
+        if (client_options->timePreset != CLIENT_OPTION_DATETIME_STRING) {
+          value = wrapTime(chars, client_options->timePreset);
+          break;
+        }
+        value = wrapString(chars, 6);
+        if (!client_options->timeFromABAP.IsEmpty()) {
+          value = client_options->timeFromABAP.Call({value});
+        }
+        break;
+      case RFCTYPE_BYTE:
+        rc = RfcGetBytesByIndex(structHandle,
+                                field.index,
+                                row + field.ucOffset,
+                                field.nucLength,
+                                &errorInfo);
+        value = Napi::Buffer<SAP_RAW>::Copy(
+            node_rfc::__env, row + field.ucOffset, field.nucLength);
+        break;
+      case RFCTYPE_INT: {
+        RFC_INT intValue = 0;
+        rc = RfcGetIntByIndex(structHandle, field.index, &intValue, &errorInfo);
+        value = Napi::Number::New(node_rfc::__env, intValue);
+        break;
+      }
+      case RFCTYPE_INT1: {
+        RFC_INT1 intValue = 0;
+        rc =
+            RfcGetInt1ByIndex(structHandle, field.index, &intValue, &errorInfo);
+        value = Napi::Number::New(node_rfc::__env, intValue);
+        break;
+      }
+      case RFCTYPE_INT2: {
+        RFC_INT2 intValue = 0;
+        rc =
+            RfcGetInt2ByIndex(structHandle, field.index, &intValue, &errorInfo);
+        value = Napi::Number::New(node_rfc::__env, intValue);
+        break;
+      }
+      default: {
+        // RFCTYPE_FLOAT
+        RFC_FLOAT floatValue = 0;
+        rc = RfcGetFloatByIndex(
+            structHandle, field.index, &floatValue, &errorInfo);
+        value = Napi::Number::New(node_rfc::__env, floatValue);
+      }
+    }
     if (rc != RFC_OK) {
-      errorPath->setFieldName(fieldDesc.name);
+      errorPath->setName(field.type, field.name);
       return ValuePair(rfcSdkError(&errorInfo, errorPath), ENV_UNDEFINED);
     }
-    ValuePair result = getVariable(fieldDesc.type,
+    // Elementary line type table has one field only, with empty name
+    if (fieldCount == 1 && *field.name == 0) {
+      return ValuePair(ENV_UNDEFINED, scope.Escape(value));
+    }
+    properties[i] = dataProperty(fieldKey(fieldKeys, typePlan, i), value);
+  }
+
+  return ValuePair(ENV_UNDEFINED,
+                   scope.Escape(newObject(properties, fieldCount)));
+}
+
+ValuePair getStructure(const BindingPlan* typePlan,
+                       RFC_STRUCTURE_HANDLE structHandle,
+                       RfmErrorPath* errorPath,
+                       ClientOptionsStruct* client_options,
+                       FieldKeys* fieldKeys) {
+  if (client_options->decoder == CLIENT_OPTION_DECODER_ROW &&
+      typePlan->flat) {
+    return getFlatStructure(
+        typePlan, structHandle, errorPath, client_options, fieldKeys);
+  }
+
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  uint_t fieldCount = typePlan->fields.size();
+  ArenaScope arena;
+  napi_property_descriptor* properties =
+      arena.alloc<napi_property_descriptor>(fieldCount);
+  for (uint_t i = 0; i < fieldCount; i++) {
+    const FieldBinding& field = typePlan->fields[i];
+    ValuePair result = getVariable(field.type,
                                    structHandle,
-                                   fieldDesc.name,
-                                   fieldDesc.nucLength,
-                                   fieldDesc.typeDescHandle,
+                                   field.name,
+                                   field.nucLength,
+                                   field.decimals,
+                                   field.typeDescHandle,
                                    errorPath,
                                    client_options);
     if (!result.first.IsUndefined()) {
       return result;
     }
-    (resultObj).Set(wrapString(fieldDesc.name), result.second);
+    // Elementary line type table has one field only, with empty name
+    if (fieldCount == 1 && *field.name == 0) {
+      return ValuePair(ENV_UNDEFINED, scope.Escape(result.second));
+    }
+    properties[i] =
+        dataProperty(fieldKey(fieldKeys, typePlan, i), result.second);
   }
 
-  if (fieldCount == 1) {
-    Napi::String fieldName =
-        resultObj.GetPropertyNames().Get((uint_t)0).As<Napi::String>();
-    if (fieldName.Utf8Value().size() == 0) {
-      return ValuePair(ENV_UNDEFINED, scope.Escape(resultObj.Get(fieldName)));
+  return ValuePair(ENV_UNDEFINED,
+                   scope.Escape(newObject(properties, fieldCount)));
+}
+
+Napi::Object ExportColumns::init(const BindingPlan* typePlan,
+                                 uint_t rowCount,
+                                 ClientOptionsStruct* client_options) {
+  uint_t fieldCount = typePlan->fields.size();
+  Napi::Object resultObj = Napi::Object::New(node_rfc::__env);
+  columns.assign(fieldCount, Napi::Array());
+  intColumns.assign(fieldCount, nullptr);
+  int8Columns.assign(fieldCount, nullptr);
+  floatColumns.assign(fieldCount, nullptr);
+  for (uint_t f = 0; f < fieldCount; f++) {
+    const FieldBinding* field = &typePlan->fields[f];
+    Napi::Value column;
+    switch (field->type) {
+      case RFCTYPE_INT:
+      case RFCTYPE_INT1:
+      case RFCTYPE_INT2: {
+        Napi::Int32Array intColumn =
+            Napi::Int32Array::New(node_rfc::__env, rowCount);
+        intColumns[f] = intColumn.Data();
+        column = intColumn;
+        break;
+      }
+      case RFCTYPE_FLOAT: {
+        Napi::Float64Array floatColumn =
+            Napi::Float64Array::New(node_rfc::__env, rowCount);
+        floatColumns[f] = floatColumn.Data();
+        column = floatColumn;
+        break;
+      }
+      case RFCTYPE_INT8: {
+        if (client_options->bigint) {
+          Napi::BigInt64Array int8Column =
+              Napi::BigInt64Array::New(node_rfc::__env, rowCount);
+          int8Columns[f] = int8Column.Data();
+          column = int8Column;
+          break;
+        }
+        columns[f] = Napi::Array::New(node_rfc::__env);
+        column = columns[f];
+        break;
+      }
+      default: {
+        columns[f] = Napi::Array::New(node_rfc::__env);
+        column = columns[f];
+      }
+    }
+    // Elementary line type table has one column only, with empty name
+    if (fieldCount == 1 && *field->name == 0) {
+      resultObj = column.As<Napi::Object>();
+    } else {
+      resultObj.Set(wrapString(field->name), column);
     }
   }
+  return resultObj;
+}
+
+ValuePair getTableColumns(RFC_TYPE_DESC_HANDLE typeDesc,
+                          RFC_TABLE_HANDLE tableHandle,
+                          uint_t rowCount,
+                          RfmErrorPath* errorPath,
+                          ClientOptionsStruct* client_options) {
+  Napi::EscapableHandleScope scope(node_rfc::__env);
+
+  RFC_RC rc = RFC_OK;
+  RFC_ERROR_INFO errorInfo;
+
+  BindingPlanPtr typePlan = _metadata.getTypePlan(typeDesc, &errorInfo);
+  if (typePlan == nullptr) {
+    return ValuePair(scope.Escape(rfcSdkError(&errorInfo, errorPath)),
+                     ENV_UNDEFINED);
+  }
+  uint_t fieldCount = typePlan->fields.size();
+
+  ExportColumns columns;
+  Napi::Object resultObj =
+      columns.init(typePlan.get(), rowCount, client_options);
+
+  if (rowCount > 0) {
+    rc = RfcMoveToFirstRow(tableHandle, &errorInfo);
+  }
+  for (uint_t i = 0; i < rowCount && rc == RFC_OK; i++) {
+    errorPath->table_line = i;
+    for (uint_t f = 0; f < fieldCount && rc == RFC_OK; f++) {
+      const FieldBinding* field = &typePlan->fields[f];
+      if (columns.intColumns[f] != nullptr) {
+        if (field->type == RFCTYPE_INT) {
+          RFC_INT intValue;
+          rc = RfcGetIntByIndex(tableHandle, f, &intValue, &errorInfo);
+          columns.intColumns[f][i] = intValue;
+        } else if (field->type == RFCTYPE_INT1) {
+          RFC_INT1 intValue;
+          rc = RfcGetInt1ByIndex(tableHandle, f, &intValue, &errorInfo);
+          columns.intColumns[f][i] = intValue;
+        } else {
+          RFC_INT2 intValue;
+          rc = RfcGetInt2ByIndex(tableHandle, f, &intValue, &errorInfo);
+          columns.intColumns[f][i] = intValue;
+        }
+      } else if (columns.int8Columns[f] != nullptr) {
+        RFC_INT8 intValue;
+        rc = RfcGetInt8ByIndex(tableHandle, f, &intValue, &errorInfo);
+        columns.int8Columns[f][i] = intValue;
+      } else if (columns.floatColumns[f] != nullptr) {
+        rc = RfcGetFloatByIndex(
+            tableHandle, f, &columns.floatColumns[f][i], &errorInfo);
+      } else {
+        ValuePair result = getVariable(field->type,
+                                       tableHandle,
+                                       field->name,
+                                       field->nucLength,
+                                       field->decimals,
+                                       field->typeDescHandle,
+                                       errorPath,
+                                       client_options);
+        if (!result.first.IsUndefined()) {
+          return result;
+        }
+        columns.columns[f].Set(i, result.second);
+      }
+    }
+    if (rc == RFC_OK && i + 1 < rowCount) {
+      rc = RfcMoveToNextRow(tableHandle, &errorInfo);
+    }
+  }
+
+  if (rc != RFC_OK) {
+    return ValuePair(scope.Escape(rfcSdkError(&errorInfo, errorPath)),
+                     ENV_UNDEFINED);
+  }
 
   return ValuePair(ENV_UNDEFINED, scope.Escape(resultObj));
 }
 
 ValuePair getVariable(RFCTYPE typ,
                       RFC_FUNCTION_HANDLE functionHandle,
-                      SAP_UC* cName,
+                      const SAP_UC* cName,
                       uint_t cLen,
+                      uint_t decimals,
                       RFC_TYPE_DESC_HANDLE typeDesc,
                       RfmErrorPath* errorPath,
                       ClientOptionsStruct* client_options) {
@@ -552,6 +1068,7 @@ ValuePair getVariable(RFCTYPE typ,
   RFC_RC rc = RFC_OK;
   RFC_ERROR_INFO errorInfo;
   RFC_STRUCTURE_HANDLE structHandle;
+  ArenaScope arena;
 
   errorPath->setName(typ, cName);
 
@@ -562,8 +1079,13 @@ ValuePair getVariable(RFCTYPE typ,
         break;
       }
 
-      ValuePair result =
-          getStructure(typeDesc, structHandle, errorPath, client_options);
+      BindingPlanPtr typePlan = _metadata.getTypePlan(typeDesc, &errorInfo);
+      if (typePlan == nullptr) {
+        rc = errorInfo.code;
+        break;
+      }
+      ValuePair result = getStructure(
+          typePlan.get(), structHandle, errorPath, client_options);
       if (!result.first.IsUndefined()) {
         return result;
       }
@@ -578,37 +1100,65 @@ ValuePair getVariable(RFCTYPE typ,
       }
       uint_t rowCount;
       rc = RfcGetRowCount(tableHandle, &rowCount, &errorInfo);
+      if (rc != RFC_OK) {
+        break;
+      }
 
+      if (client_options->table == CLIENT_OPTION_TABLE_COLUMNS) {
+        ValuePair result = getTableColumns(
+            typeDesc, tableHandle, rowCount, errorPath, client_options);
+        if (!result.first.IsUndefined()) {
+          return result;
+        }
+        resultValue = result.second;
+        break;
+      }
+
+      // Rows are read forward and appended in index order, keeping the
+      // array elements packed. Not preallocated, because large arrays
+      // created with length start in dictionary mode.
+      BindingPlanPtr typePlan = _metadata.getTypePlan(typeDesc, &errorInfo);
+      if (typePlan == nullptr) {
+        rc = errorInfo.code;
+        break;
+      }
       Napi::Array table = Napi::Array::New(node_rfc::__env);
+      FieldKeys fieldKeys;
 
-      while (rowCount-- > 0) {
-        errorPath->table_line = rowCount;
-        RfcMoveTo(tableHandle, rowCount, nullptr);
-        ValuePair result =
-            getStructure(typeDesc, tableHandle, errorPath, client_options);
+      if (rowCount > 0) {
+        rc = RfcMoveToFirstRow(tableHandle, &errorInfo);
+      }
+      for (uint_t i = 0; i < rowCount && rc == RFC_OK; i++) {
+        errorPath->table_line = i;
+        ValuePair result = getStructure(typePlan.get(),
+                                        tableHandle,
+                                        errorPath,
+                                        client_options,
+                                        &fieldKeys);
         if (!result.first.IsUndefined()) {
           return result;
         }
-        RfcDeleteCurrentRow(tableHandle, &errorInfo);
-        (table).Set(rowCount, result.second);
+        table.Set(i, result.second);
+        if (i + 1 < rowCount) {
+          rc = RfcMoveToNextRow(tableHandle, &errorInfo);
+        }
       }
       resultValue = table;
       break;
     }
     case RFCTYPE_CHAR: {
-      RFC_CHAR* charValue = new RFC_CHAR[cLen];
+      RFC_CHAR* charValue = arena.alloc<RFC_CHAR>(cLen);
       rc = RfcGetChars(functionHandle, cName, charValue, cLen, &errorInfo);
       if (rc != RFC_OK) {
         break;
       }
       resultValue = wrapString(charValue, cLen);
-      delete[] charValue;
       break;
     }
     case RFCTYPE_STRING: {
       uint_t resultLen = 0, strLen = 0;
       RfcGetStringLength(functionHandle, cName, &strLen, &errorInfo);
-      SAP_UC* stringValue = new RFC_CHAR[strLen + 1];
+      SAP_UC* stringValue = arena.alloc<SAP_UC>(strLen + 1);
       rc = RfcGetString(functionHandle,
                         cName,
                         stringValue,
@@ -619,32 +1169,26 @@ ValuePair getVariable(RFCTYPE typ,
         break;
       }
       resultValue = wrapString(stringValue, strLen);
-      delete[] stringValue;
       break;
     }
     case RFCTYPE_NUM: {
-      RFC_NUM* numValue = new RFC_CHAR[cLen];
+      RFC_NUM* numValue = arena.alloc<RFC_NUM>(cLen);
       rc = RfcGetNum(functionHandle, cName, numValue, cLen, &errorInfo);
       if (rc != RFC_OK) {
-        delete[] numValue;
         break;
       }
       resultValue = wrapString(numValue, cLen);
-      delete[] numValue;
       break;
     }
     case RFCTYPE_BYTE: {
-      SAP_RAW* byteValue = new SAP_RAW[cLen];
+      SAP_RAW* byteValue = arena.alloc<SAP_RAW>(cLen);
 
       rc = RfcGetBytes(functionHandle, cName, byteValue, cLen, &errorInfo);
       if (rc != RFC_OK) {
-        delete[] byteValue;
         break;
       }
-      resultValue = Napi::Buffer<SAP_RAW>::New(
-          node_rfc::__env, byteValue, cLen, [](void*, SAP_RAW* byteValue) {
-            delete[] byteValue;
-          });
+      resultValue =
+          Napi::Buffer<SAP_RAW>::Copy(node_rfc::__env, byteValue, cLen);
       break;
     }
 
@@ -652,58 +1196,17 @@ ValuePair getVariable(RFCTYPE typ,
       uint_t strLen, resultLen;
       RfcGetStringLength(functionHandle, cName, &strLen, &errorInfo);
 
-      SAP_RAW* byteValue = new SAP_RAW[strLen + 1];
+      SAP_RAW* byteValue = arena.alloc<SAP_RAW>(strLen + 1);
       byteValue[strLen] = '\0';
 
       rc = RfcGetXString(
           functionHandle, cName, byteValue, strLen, &resultLen, &errorInfo);
 
       if (rc != RFC_OK) {
-        delete[] byteValue;
         break;
       }
-      resultValue = Napi::Buffer<SAP_RAW>::New(
-          node_rfc::__env, byteValue, resultLen, [](void*, SAP_RAW* byteValue) {
-            delete[] byteValue;
-          });
-      break;
-    }
-    case RFCTYPE_BCD: {
-      // An upper bound for the length of the _string representation_
-      // of the BCD is given by (2*cLen)-1 (each digit is encoded in 4bit,
-      // the first 4 bit are reserved for the sign)
-      // Furthermore, a sign char, a decimal separator char may be present
-      // => (2*cLen)+1
-      uint_t resultLen;
-      uint_t strLen = 2 * cLen + 1;
-      SAP_UC* sapuc = new SAP_UC[strLen + 1];
-      rc = RfcGetString(
-          functionHandle, cName, sapuc, strLen + 1, &resultLen, &errorInfo);
-      if (rc == 23)  // Buffer too small, use returned requried result length
-      {
-        _log.warning(logClass::nwrfc,
-                     "Buffer for BCD type ",
-                     typ,
-                     " too small, for ",
-                     errorPath->pathstr());
-        delete[] sapuc;
-        strLen = resultLen;
-        sapuc = new SAP_UC[strLen + 1];
-        rc = RfcGetString(
-            functionHandle, cName, sapuc, strLen + 1, &resultLen, &errorInfo);
-      }
-      if (rc != RFC_OK) {
-        delete[] sapuc;
-        break;
-      }
-      resultValue = wrapString(sapuc, resultLen).ToString();
-      delete[] sapuc;
-
-      if (client_options->bcd == CLIENT_OPTION_BCD_FUNCTION) {
-        resultValue = client_options->bcdFunction.Call({resultValue});
-      } else if (client_options->bcd == CLIENT_OPTION_BCD_NUMBER) {
-        resultValue = resultValue.ToNumber();
-      }
+      resultValue =
+          Napi::Buffer<SAP_RAW>::Copy(node_rfc::__env, byteValue, resultLen);
       break;
     }
     case RFCTYPE_FLOAT: {
@@ -712,6 +1215,7 @@ ValuePair getVariable(RFCTYPE typ,
       resultValue = Napi::Number::New(node_rfc::__env, floatValue);
       break;
     }
+    case RFCTYPE_BCD:
     case RFCTYPE_DECF16:
     case RFCTYPE_DECF34: {
       // An upper bound for the length of the _string representation_
@@ -719,11 +1223,11 @@ ValuePair getVariable(RFCTYPE typ,
       // the first 4 bit are reserved for the sign)
       // Furthermore, a sign char, a decimal separator char may be present
       // => (2*cLen)+1
-      // and exponent char, sign and exponent
+      // and for DECF exponent char, sign and exponent
       // => +9
       uint_t resultLen;
-      uint_t strLen = 2 * cLen + 10;
-      SAP_UC* sapuc = new SAP_UC[strLen + 1];
+      uint_t strLen = typ == RFCTYPE_BCD ? 2 * cLen + 1 : 2 * cLen + 10;
+      SAP_UC* sapuc = arena.alloc<SAP_UC>(strLen + 1);
       rc = RfcGetString(
           functionHandle, cName, sapuc, strLen + 1, &resultLen, &errorInfo);
       if (rc == 23)  // Buffer too small, use returned requried result length
@@ -733,18 +1237,29 @@ ValuePair getVariable(RFCTYPE typ,
                      typ,
                      " too small, for ",
                      errorPath->pathstr());
-        delete[] sapuc;
         strLen = resultLen;
-        sapuc = new SAP_UC[strLen + 1];
+        sapuc = arena.alloc<SAP_UC>(strLen + 1);
         rc = RfcGetString(
             functionHandle, cName, sapuc, strLen + 1, &resultLen, &errorInfo);
       }
       if (rc != RFC_OK) {
-        delete[] sapuc;
         break;
       }
+
+      double number;
+      if (client_options->bcd == CLIENT_OPTION_BCD_NUMBER &&
+          parseDecimal(sapuc, resultLen, &number)) {
+        resultValue = Napi::Number::New(node_rfc::__env, number);
+        break;
+      }
+      if (client_options->bcd == CLIENT_OPTION_BCD_SCALED_BIGINT) {
+        resultValue = wrapScaledDecimal(
+            sapuc, resultLen, client_options->decimalScale(decimals));
+        if (!resultValue.IsEmpty()) {
+          break;
+        }
+      }
       resultValue = wrapString(sapuc, resultLen).ToString();
-      delete[] sapuc;
 
       if (client_options->bcd == CLIENT_OPTION_BCD_FUNCTION) {
         resultValue = client_options->bcdFunction.Call({resultValue});
@@ -786,12 +1301,17 @@ ValuePair getVariable(RFCTYPE typ,
       if (rc != RFC_OK) {
         break;
       }
-      resultValue = Napi::Number::New(node_rfc::__env, intValue);
+      if (client_options->bigint) {
+        resultValue = Napi::BigInt::New(node_rfc::__env,
+                                        static_cast<int64_t>(intValue));
+      } else {
+        resultValue = Napi::Number::New(node_rfc::__env, intValue);
+      }
       break;
     }
     case RFCTYPE_UTCLONG: {
       uint_t resultLen = 0, strLen = 27;
-      SAP_UC* stringValue = new SAP_UC[strLen + 1];
+      SAP_UC* stringValue = arena.alloc<SAP_UC>(strLen + 1);
       rc = RfcGetString(functionHandle,
                         cName,
                         stringValue,
@@ -803,7 +1323,6 @@ ValuePair getVariable(RFCTYPE typ,
       }
       stringValue[19] = '.';
       resultValue = wrapString(stringValue, strLen);
-      delete[] stringValue;
       break;
     }
     case RFCTYPE_DATE: {
@@ -812,6 +1331,10 @@ ValuePair getVariable(RFCTYPE typ,
       if (rc != RFC_OK) {
         break;
       }
+      if (client_options->datePreset != CLIENT_OPTION_DATETIME_STRING) {
+        resultValue = wrapDate(dateValue, client_options->datePreset);
+        break;
+      }
       resultValue = wrapString(dateValue, 8);
       if (!client_options->dateFromABAP.IsEmpty()) {
         resultValue = client_options->dateFromABAP.Call({resultValue});
@@ -824,6 +1347,10 @@ ValuePair getVariable(RFCTYPE typ,
       if (rc != RFC_OK) {
         break;
       }
+      if (client_options->timePreset != CLIENT_OPTION_DATETIME_STRING) {
+        resultValue = wrapTime(timeValue, client_options->timePreset);
+        break;
+      }
       resultValue = wrapString(timeValue, 6);
       if (!client_options->timeFromABAP.IsEmpty()) {
         resultValue = client_options->timeFromABAP.Call({resultValue});
@@ -971,6 +1498,38 @@ void getConnectionParams(Napi::Object clientParamsObject,
   }
 }
 
+static uint_t checkDateTimePreset(const char* option, Napi::String value) {
+  std::string preset = value.Utf8Value();
+  for (uint_t p = CLIENT_OPTION_DATETIME_STRING;
+       p <= CLIENT_OPTION_DATETIME_ISO;
+       p++) {
+    if (preset == dateTimePresetName(p)) {
+      return p;
+    }
+  }
+  char errmsg[ERRMSG_LENGTH];
+  snprintf(errmsg,
+           ERRMSG_LENGTH - 1,
+           "Client option \"%s\" value not allowed: \"%s\"",
+           option,
+           &preset[0]);
+  Napi::TypeError::New(node_rfc::__env, errmsg).ThrowAsJavaScriptException();
+  return CLIENT_OPTION_DATETIME_STRING;
+}
+
+// Option value for error messages. Only primitives are converted, objects
+// may have own toString().
+static std::string optionValue(Napi::Value opt) {
+  if (opt.IsString() || opt.IsNumber() || opt.IsBoolean() || opt.IsBigInt() ||
+      opt.IsNull() || opt.IsUndefined()) {
+    return opt.ToString().Utf8Value();
+  }
+  if (opt.Type() == napi_symbol) {
+    return "symbol";
+  }
+  return opt.IsFunction() ? "function" : "object";
+}
+
 void checkClientOptions(Napi::Object clientOptionsObject,
                         ClientOptionsStruct* client_options) {
   if (clientOptionsObject.Has("clientOptions")) {
@@ -993,8 +1552,13 @@ void checkClientOptions(Napi::Object clientOptionsObject,
             Napi::Persistent(opt.As<Napi::Function>());
       } else if (opt.IsString()) {
         std::string bcdString = opt.ToString().Utf8Value();
-        if (bcdString == "number") {
+        if (bcdString == "string") {
+          client_options->bcd = CLIENT_OPTION_BCD_STRING;
+        } else if (bcdString == "number") {
           client_options->bcd = CLIENT_OPTION_BCD_NUMBER;
+        } else if (bcdString == "scaledBigInt") {
+          client_options->bcd = CLIENT_OPTION_BCD_SCALED_BIGINT;
+          client_options->bcdScale = -1;
         } else {
           snprintf(errmsg,
                    ERRMSG_LENGTH - 1,
@@ -1004,12 +1568,34 @@ void checkClientOptions(Napi::Object clientOptionsObject,
           Napi::TypeError::New(node_rfc::__env, errmsg)
               .ThrowAsJavaScriptException();
         }
+      } else if (opt.IsObject()) {
+        // {scale: N}
+        Napi::Value scale = opt.As<Napi::Object>().Get("scale");
+        double scaleNumber = scale.IsNumber() ? scale.ToNumber().DoubleValue()
+                                              : -1;
+        if (scaleNumber < 0 || scaleNumber > CLIENT_OPTION_BCD_SCALE_MAX ||
+            scaleNumber != (int)scaleNumber) {
+          std::string scaleString = scale.ToString().Utf8Value();
+          snprintf(errmsg,
+                   ERRMSG_LENGTH - 1,
+                   "Client option \"%s\" scale not allowed: \"%s\"",
+                   CLIENT_OPTION_BCD,
+                   &scaleString[0]);
+          Napi::TypeError::New(node_rfc::__env, errmsg)
+              .ThrowAsJavaScriptException();
+        } else {
+          client_options->bcd = CLIENT_OPTION_BCD_SCALED_BIGINT;
+          client_options->bcdScale = static_cast<int>(scaleNumber);
+        }
       }
     }
 
     // Client option: "date"
     else if (key == CLIENT_OPTION_DATE) {
-      if (!opt.IsObject()) {
+      if (opt.IsString()) {
+        client_options->datePreset =
+            checkDateTimePreset(CLIENT_OPTION_DATE, opt.As<Napi::String>());
+      } else if (!opt.IsObject()) {
         opt = node_rfc::__env.Null();
       } else {
         Napi::Value toABAP = opt.As<Napi::Object>().Get("toABAP");
@@ -1033,7 +1619,10 @@ void checkClientOptions(Napi::Object clientOptionsObject,
 
     // Client option: "time"
     else if (key == CLIENT_OPTION_TIME) {
-      if (!opt.IsObject()) {
+      if (opt.IsString()) {
+        client_options->timePreset =
+            checkDateTimePreset(CLIENT_OPTION_TIME, opt.As<Napi::String>());
+      } else if (!opt.IsObject()) {
         opt = node_rfc::__env.Null();
       } else {
         Napi::Value toABAP = opt.As<Napi::Object>().Get("toABAP");
@@ -1087,6 +1676,19 @@ void checkClientOptions(Napi::Object clientOptionsObject,
       client_options->stateless = opt.As<Napi::Boolean>();
     }
 
+    // Client option: "bigint"
+    else if (key == CLIENT_OPTION_BIGINT) {
+      if (!opt.IsBoolean()) {
+        snprintf(errmsg,
+                 ERRMSG_LENGTH - 1,
+                 "Client option \"%s\" requires a boolean value",
+                 CLIENT_OPTION_BIGINT);
+        Napi::TypeError::New(node_rfc::__env, errmsg)
+            .ThrowAsJavaScriptException();
+      }
+      client_options->bigint = opt.As<Napi::Boolean>();
+    }
+
     // Client option: "timeout"
     else if (key == CLIENT_OPTION_TIMEOUT) {
       if (!opt.IsNumber()) {
@@ -1100,6 +1702,42 @@ void checkClientOptions(Napi::Object clientOptionsObject,
       client_options->timeout = opt.As<Napi::Number>();
     }
 
+    // Client option: "decoder"
+    else if (key == CLIENT_OPTION_DECODER) {
+      std::string decoderString = optionValue(opt);
+      if (opt.IsString() && decoderString == "field") {
+        client_options->decoder = CLIENT_OPTION_DECODER_FIELD;
+      } else if (opt.IsString() && decoderString == "row") {
+        client_options->decoder = CLIENT_OPTION_DECODER_ROW;
+      } else {
+        snprintf(errmsg,
+                 ERRMSG_LENGTH - 1,
+                 "Client option \"%s\" value not allowed: \"%s\"",
+                 CLIENT_OPTION_DECODER,
+                 &decoderString[0]);
+        Napi::TypeError::New(node_rfc::__env, errmsg)
+            .ThrowAsJavaScriptException();
+      }
+    }
+
+    // Client option: "table"
+    else if (key == CLIENT_OPTION_TABLE) {
+      std::string tableString = optionValue(opt);
+      if (opt.IsString() && tableString == "rows") {
+        client_options->table = CLIENT_OPTION_TABLE_ROWS;
+      } else if (opt.IsString() && tableString == "columns") {
+        client_options->table = CLIENT_OPTION_TABLE_COLUMNS;
+      } else {
+        snprintf(errmsg,
+                 ERRMSG_LENGTH - 1,
+                 "Client option \"%s\" value not allowed: \"%s\"",
+                 CLIENT_OPTION_TABLE,
+                 &tableString[0]);
+        Napi::TypeError::New(node_rfc::__env, errmsg)
+            .ThrowAsJavaScriptException();
+      }
+    }
+
     else if (key == SRV_OPTION_LOG_LEVEL) {
       _log.set_log_level(logClass::client, opt);
     }
@@ -5,7 +5,11 @@
 #ifndef NodeRfc_SDK_H_
 #define NodeRfc_SDK_H_
 
+#include <memory>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
+#include "Arena.h"
 #include "Log.h"
 #include "noderfc.h"
 
@@ -17,6 +21,49 @@ extern Napi::Env __env;
 extern Log _log;
 
 Napi::Value wrapString(const SAP_UC* uc, int length = -1);
+// Appends SAP unicode string to UTF-8 buffer, trailing whitespaces trimmed.
+// No NodeJS API used, can run in worker thread. Optional ascii is set when
+// all appended characters are ASCII.
+bool appendUtf8(const SAP_UC* uc,
+                uint_t length,
+                std::string* utf8,
+                bool* ascii = nullptr);
+// NodeJS string from UTF-8, created as one-byte string when ASCII
+Napi::String newString(const char* utf8, size_t length, bool ascii);
+// NodeJS object with data properties defined in one call. Objects created
+// with the same keys in the same order share one hidden class.
+Napi::Object newObject(const napi_property_descriptor* properties,
+                       size_t count);
+// Enumerable, writable and configurable data property
+inline napi_property_descriptor dataProperty(napi_value name,
+                                             napi_value value) {
+  return {nullptr,
+          name,
+          nullptr,
+          nullptr,
+          nullptr,
+          value,
+          napi_default_jsproperty,
+          nullptr};
+}
+
+// Client options "date" and "time" presets: ABAP date YYYYMMDD and time
+// HHMMSS to NodeJS Date, epoch milliseconds or ISO string. Initial and
+// invalid values are returned as null.
+const char* dateTimePresetName(uint_t preset);
+Napi::Value wrapDate(const char* date, uint_t preset);
+Napi::Value wrapDate(const SAP_UC* date, uint_t preset);
+Napi::Value wrapTime(const char* time, uint_t preset);
+Napi::Value wrapTime(const SAP_UC* time, uint_t preset);
+// NodeJS value of the preset, null, or ABAP string with or without ISO
+// separators, to 8 chars date or 6 chars time. False for other values.
+bool unwrapDate(Napi::Value value, uint_t preset, char* date);
+bool unwrapTime(Napi::Value value, uint_t preset, char* time);
+
+// Client option "bcd" scaled BigInt preset: ABAP decimal digits times
+// 10^scale to BigInt, empty value for non-decimal input, and back
+Napi::Value wrapScaledDecimal(const SAP_UC* uc, uint_t length, int scale);
+std::string unwrapScaledDecimal(Napi::BigInt value, int scale);
 
 //
 // Client connection parameters internal representation
@@ -48,8 +95,14 @@ typedef struct _ConnectionParamsStruct {
 //
 typedef struct _ClientOptionsStruct {
   uint_t bcd = CLIENT_OPTION_BCD_STRING;
+  int bcdScale = -1;  // scaled BigInt decimals, -1 for ABAP field decimals
   bool stateless = false;
+  bool bigint = false;
   uint_t timeout = 0;
+  uint_t table = CLIENT_OPTION_TABLE_ROWS;
+  uint_t decoder = CLIENT_OPTION_DECODER_FIELD;
+  uint_t datePreset = CLIENT_OPTION_DATETIME_STRING;
+  uint_t timePreset = CLIENT_OPTION_DATETIME_STRING;
   RFC_DIRECTION filter_param_type = (RFC_DIRECTION)0;
   Napi::FunctionReference bcdFunction;
   Napi::FunctionReference dateToABAP;
@@ -57,6 +110,11 @@ typedef struct _ClientOptionsStruct {
   Napi::FunctionReference timeToABAP;
   Napi::FunctionReference timeFromABAP;
 
+  // Scale of decimal values with scaled BigInt preset
+  int decimalScale(uint_t decimals) const {
+    return bcdScale >= 0 ? bcdScale : static_cast<int>(decimals);
+  }
+
   Napi::Value _Value(Napi::Env env) {
     Napi::Object options = Napi::Object::New(env);
 
@@ -67,10 +125,21 @@ typedef struct _ClientOptionsStruct {
     options.Set(CLIENT_OPTION_STATELESS,
                 Napi::Boolean::New(env, stateless));
 
+    // bigint
+    options.Set(CLIENT_OPTION_BIGINT, Napi::Boolean::New(env, bigint));
+
     // filter
     options.Set(CLIENT_OPTION_FILTER,
                 Napi::Number::New(env, filter_param_type));
 
+    // table
+    options.Set(CLIENT_OPTION_TABLE,
+                table == CLIENT_OPTION_TABLE_COLUMNS ? "columns" : "rows");
+
+    // decoder
+    options.Set(CLIENT_OPTION_DECODER,
+                decoder == CLIENT_OPTION_DECODER_ROW ? "row" : "field");
+
     // bcd
     if (bcd == CLIENT_OPTION_BCD_STRING) {
       options.Set(CLIENT_OPTION_BCD, "string");
@@ -78,37 +147,51 @@ typedef struct _ClientOptionsStruct {
       options.Set(CLIENT_OPTION_BCD, "number");
     } else if (bcd == CLIENT_OPTION_BCD_FUNCTION) {
       options.Set(CLIENT_OPTION_BCD, bcdFunction.Value());
+    } else if (bcd == CLIENT_OPTION_BCD_SCALED_BIGINT && bcdScale < 0) {
+      options.Set(CLIENT_OPTION_BCD, "scaledBigInt");
+    } else if (bcd == CLIENT_OPTION_BCD_SCALED_BIGINT) {
+      Napi::Object obcd = Napi::Object::New(env);
+      obcd.Set("scale", Napi::Number::New(env, bcdScale));
+      options.Set(CLIENT_OPTION_BCD, obcd);
     } else {
       options.Set(CLIENT_OPTION_BCD, "?");
     }
 
     // date
-    Napi::Object odate = Napi::Object::New(env);
-    if (!dateToABAP.IsEmpty()) {
-      odate.Set("toABAP", dateToABAP.Value());
-    } else {
-      odate.Set("toABAP", "string");
-    }
-    if (!dateFromABAP.IsEmpty()) {
-      odate.Set("fromABAP", dateFromABAP.Value());
+    if (datePreset != CLIENT_OPTION_DATETIME_STRING) {
+      options.Set(CLIENT_OPTION_DATE, dateTimePresetName(datePreset));
     } else {
-      odate.Set("fromABAP", "string");
+      Napi::Object odate = Napi::Object::New(env);
+      if (!dateToABAP.IsEmpty()) {
+        odate.Set("toABAP", dateToABAP.Value());
+      } else {
+        odate.Set("toABAP", "string");
+      }
+      if (!dateFromABAP.IsEmpty()) {
+        odate.Set("fromABAP", dateFromABAP.Value());
+      } else {
+        odate.Set("fromABAP", "string");
+      }
+      options.Set(CLIENT_OPTION_DATE, odate);
     }
-    options.Set(CLIENT_OPTION_DATE, odate);
 
     // time
-    Napi::Object otime = Napi::Object::New(env);
-    if (!timeToABAP.IsEmpty()) {
-      otime.Set("toABAP", timeToABAP.Value());
+    if (timePreset != CLIENT_OPTION_DATETIME_STRING) {
+      options.Set(CLIENT_OPTION_TIME, dateTimePresetName(timePreset));
     } else {
-      otime.Set("toABAP", "string");
-    }
-    if (!timeFromABAP.IsEmpty()) {
-      otime.Set("fromABAP", timeFromABAP.Value());
-    } else {
-      otime.Set("fromABAP", "string");
+      Napi::Object otime = Napi::Object::New(env);
+      if (!timeToABAP.IsEmpty()) {
+        otime.Set("toABAP", timeToABAP.Value());
+      } else {
+        otime.Set("toABAP", "string");
+      }
+      if (!timeFromABAP.IsEmpty()) {
+        otime.Set("fromABAP", timeFromABAP.Value());
+      } else {
+        otime.Set("fromABAP", "string");
+      }
+      options.Set(CLIENT_OPTION_TIME, otime);
     }
-    options.Set(CLIENT_OPTION_TIME, otime);
 
     Napi::EscapableHandleScope scope(env);
     return scope.Escape(options);
@@ -118,11 +201,17 @@ typedef struct _ClientOptionsStruct {
       _ClientOptionsStruct& pool_client_options)  // note: passed by copy
   {
     bcd = pool_client_options.bcd;
+    bcdScale = pool_client_options.bcdScale;
     stateless = pool_client_options.stateless;
+    bigint = pool_client_options.bigint;
     filter_param_type = pool_client_options.filter_param_type;
     timeout = pool_client_options.timeout;
+    table = pool_client_options.table;
+    decoder = pool_client_options.decoder;
+    datePreset = pool_client_options.datePreset;
+    timePreset = pool_client_options.timePreset;
     // bcd
-    if (!pool_client_options.bcdFunction) {
+    if (!pool_client_options.bcdFunction.IsEmpty()) {
       bcdFunction = Napi::Persistent(pool_client_options.bcdFunction.Value());
     }
     // date
@@ -186,7 +275,7 @@ typedef struct _RfmErrorPath {
     fieldName[0] = 0;
   }
 
-  void setName(RFCTYPE typ, SAP_UC* cName) {
+  void setName(RFCTYPE typ, const SAP_UC* cName) {
     if (typ == RFCTYPE_STRUCTURE) {
       strcpyU(structureName, cName);
     } else if (typ == RFCTYPE_TABLE) {
@@ -196,17 +285,17 @@ typedef struct _RfmErrorPath {
     }
   }
 
-  void setFunctionName(SAP_UC* funcName) {
+  void setFunctionName(const SAP_UC* funcName) {
     clear();
     strcpyU(functionName, funcName);
   }
 
-  void setParameterName(SAP_UC* pName) {
+  void setParameterName(const SAP_UC* pName) {
     resetPath();
     strcpyU(parameterName, pName);
   }
 
-  void setFieldName(SAP_UC* fName) { strcpyU(fieldName, fName); }
+  void setFieldName(const SAP_UC* fName) { strcpyU(fieldName, fName); }
 
   Napi::Object getpath() {
     Napi::Object path = Napi::Object::New(node_rfc::__env);
@@ -241,41 +330,147 @@ typedef struct _RfmErrorPath {
 
 } RfmErrorPath;
 
+//
+// RFM parameter or structure field binding
+//
+typedef struct _FieldBinding {
+  uint_t index;
+  RFCTYPE type;
+  RFC_ABAP_NAME name;
+  RFC_DIRECTION direction;
+  uint_t nucLength;
+  uint_t ucLength;
+  uint_t nucOffset;  // structure field, 0 for parameters
+  uint_t ucOffset;
+  uint_t decimals;
+  RFC_TYPE_DESC_HANDLE typeDescHandle;
+} FieldBinding;
+
+//
+// Function or type descriptor binding plan, built once per descriptor.
+// Maps NodeJS property names to parameter or field bindings. Field
+// bindings are the flat layout of the type, shared by getters and setters.
+//
+typedef struct _BindingPlan {
+  RFC_FUNCTION_DESC_HANDLE functionDescHandle = nullptr;
+  RFC_TYPE_DESC_HANDLE typeDescHandle = nullptr;
+  std::vector<FieldBinding> fields;
+  std::unordered_map<std::string, uint_t> names;
+  // Type only: structure length in bytes, flat structure with elementary
+  // fields and char-like structure with CHAR, NUM, DATE and TIME fields
+  uint_t ucLength = 0;
+  bool flat = false;
+  bool charLike = false;
+
+  // Returns nullptr and SDK error if the name not found
+  const FieldBinding* find(const std::string& name,
+                           RFC_ERROR_INFO* errorInfo) const;
+} BindingPlan;
+
+typedef std::shared_ptr<const BindingPlan> BindingPlanPtr;
+
+//
+// NodeJS field name keys, created once per type descriptor and reused for
+// all structures and table rows of that type. V8 internalizes the key on
+// first property store. Main thread only.
+//
+class FieldKeys {
+ public:
+  Napi::Value get(RFC_TYPE_DESC_HANDLE typeDescHandle,
+                  uint_t fieldCount,
+                  uint_t index,
+                  const SAP_UC* name);
+
+ private:
+  std::unordered_map<RFC_TYPE_DESC_HANDLE,
+                     std::vector<Napi::Reference<Napi::Value>>>
+      keys;
+};
+
+//
+// Table column of columnar table input. Typed array elements are read from
+// memory, Buffer column of BYTE or char-like field holds fixed width values,
+// field length bytes per row, ASCII only for char-like fields.
+//
+typedef struct _ImportColumn {
+  const FieldBinding* binding;
+  Napi::Value column;
+  napi_typedarray_type type;
+  const uint8_t* data;  // typed array elements, nullptr for array
+  uint_t width;         // fixed width values, 0 for elements
+} ImportColumn;
+
+//
+// Columnar table input, object of equal length columns: {FIELD: column}.
+// Main thread, columns valid in the caller handle scope.
+//
+class ImportColumns {
+ public:
+  // Returns the error or undefined
+  Napi::Value init(const BindingPlan* typePlan,
+                   Napi::Object value,
+                   RfmErrorPath* errorPath);
+
+  // NodeJS value of the column row, fixed width values excepted
+  Napi::Value get(const ImportColumn& column, uint_t row) const;
+  // Typed array element as number
+  static double number(const ImportColumn& column, uint_t row);
+
+  std::vector<ImportColumn> columns;
+  uint_t rowCount = 0;
+};
+
+//
+// Columnar table result, one column per field: typed arrays for INT, INT1,
+// INT2, FLOAT and, with "bigint" option, INT8. Arrays for other types.
+// Shared by the main thread and worker thread table readers. Main thread.
+//
+class ExportColumns {
+ public:
+  // Returns the result object, {FIELD: column}, or the only column of
+  // elementary line type table
+  Napi::Object init(const BindingPlan* typePlan,
+                    uint_t rowCount,
+                    ClientOptionsStruct* client_options);
+
+  std::vector<Napi::Array> columns;  // empty for typed array columns
+  std::vector<int32_t*> intColumns;
+  std::vector<int64_t*> int8Columns;
+  std::vector<double*> floatColumns;
+};
+
 typedef std::pair<Napi::Value, Napi::Value> ValuePair;
 typedef std::pair<RFC_ERROR_INFO, std::string> ErrorPair;
 
 // Write parameters (to SDK)
 SAP_UC* setString(const Napi::String napistr);
 SAP_UC* setString(std::string str);
-Napi::Value setRfmParameter(RFC_FUNCTION_DESC_HANDLE functionDescHandle,
-                            RFC_FUNCTION_HANDLE functionHandle,
-                            Napi::String name,
-                            Napi::Value value,
-                            RfmErrorPath* errorPath,
-                            ClientOptionsStruct* client_options);
-Napi::Value setStructure(RFC_STRUCTURE_HANDLE structHandle,
-                         RFC_TYPE_DESC_HANDLE functionDescHandle,
-                         SAP_UC* cName,
-                         Napi::Value value,
-                         RfmErrorPath* errorPath,
-                         ClientOptionsStruct* client_options);
-Napi::Value setVariable(RFCTYPE typ,
-                        RFC_FUNCTION_HANDLE functionHandle,
-                        SAP_UC* cName,
-                        Napi::Value value,
-                        RFC_TYPE_DESC_HANDLE functionDescHandle,
-                        RfmErrorPath* errorPath,
-                        ClientOptionsStruct* client_options);
+// NodeJS Number or BigInt to ABAP integer of type typ, range checked
+Napi::Value toInteger(RFCTYPE typ,
+                      Napi::Value value,
+                      int64_t* integer,
+                      RfmErrorPath* errorPath);
+Napi::Value checkInteger(RFCTYPE typ,
+                         int64_t integer,
+                         RfmErrorPath* errorPath);
+bool integerInRange(RFCTYPE typ, int64_t integer);
 
 // Read parameters (from SDK)
-ValuePair getStructure(RFC_TYPE_DESC_HANDLE typeDesc,
+ValuePair getStructure(const BindingPlan* typePlan,
                        RFC_STRUCTURE_HANDLE structHandle,
                        RfmErrorPath* errorPath,
-                       ClientOptionsStruct* client_options);
+                       ClientOptionsStruct* client_options,
+                       FieldKeys* fieldKeys = nullptr);
+ValuePair getTableColumns(RFC_TYPE_DESC_HANDLE typeDesc,
+                          RFC_TABLE_HANDLE tableHandle,
+                          uint_t rowCount,
+                          RfmErrorPath* errorPath,
+                          ClientOptionsStruct* client_options);
 ValuePair getVariable(RFCTYPE typ,
                       RFC_FUNCTION_HANDLE functionHandle,
-                      SAP_UC* cName,
+                      const SAP_UC* cName,
                       uint_t cLen,
+                      uint_t decimals,
                       RFC_TYPE_DESC_HANDLE typeDesc,
                       RfmErrorPath* errorPath,
                       ClientOptionsStruct* client_options);
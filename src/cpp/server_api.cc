@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "server_api.h"
+#include "ParameterBuffer.h"
 
 namespace node_rfc {
 
@@ -405,25 +406,15 @@ class GenericFunctionHandler {
 
   // Transform JavaScript parameters' data to ABAP
   void setResponseData(Napi::Env env, Napi::Value jsResult) {
-    Napi::Value errorObj = env.Undefined();
-    Napi::Object params = jsResult.As<Napi::Object>();
-    Napi::Array paramNames = params.GetPropertyNames();
-    uint_t paramCount = paramNames.Length();
-    for (uint_t ii = 0; ii < paramCount; ii++) {
-      Napi::String name = paramNames.Get(ii).ToString();
-      Napi::Value value = params.Get(name);
-
-      // _log.record(logClass::server, logLevel::debug, name, value);
-      errorObj = setRfmParameter(handlerFunction->func_desc_handle,
-                                 func_handle,
-                                 name,
-                                 value,
-                                 &errorPath,
-                                 &client_options);
-
-      if (!errorObj.IsUndefined()) {
-        break;
-      }
+    // Same conversion as for client calls
+    ParameterBuffer parameters;
+    Napi::Value errorObj =
+        parameters.snapshot(handlerFunction->func_desc_handle,
+                            jsResult.As<Napi::Object>(),
+                            &errorPath,
+                            &client_options);
+    if (errorObj.IsUndefined() && !parameters.fill(func_handle)) {
+      errorObj = parameters.error();
     }
 
     // genericRequestHandler will check for error and return result to ABAP
@@ -542,25 +533,15 @@ Napi::Value ServerRequestBaton::getServerRequestContext() {
 
 // Transform JavaScript parameters' data to ABAP
 void ServerRequestBaton::setResponseData(Napi::Env env, Napi::Value jsResult) {
-  Napi::Value errorObj = env.Undefined();
-  Napi::Object params = jsResult.As<Napi::Object>();
-  Napi::Array paramNames = params.GetPropertyNames();
-  uint_t paramCount = paramNames.Length();
-  for (uint_t ii = 0; ii < paramCount; ii++) {
-    Napi::String name = paramNames.Get(ii).ToString();
-    Napi::Value value = params.Get(name);
-
-    // _log.record(logClass::server, logLevel::debug, name, value);
-    errorObj = setRfmParameter(handlerFunction->func_desc_handle,
-                               func_handle,
-                               name,
-                               value,
-                               &errorPath,
-                               &client_options);
-
-    if (!errorObj.IsUndefined()) {
-      break;
-    }
+  // Same conversion as for client calls
+  ParameterBuffer parameters;
+  Napi::Value errorObj =
+      parameters.snapshot(handlerFunction->func_desc_handle,
+                          jsResult.As<Napi::Object>(),
+                          &errorPath,
+                          &client_options);
+  if (errorObj.IsUndefined() && !parameters.fill(func_handle)) {
+    errorObj = parameters.error();
   }
 
   // genericRequestHandler will check for error and return result to ABAP
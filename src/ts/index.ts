@@ -17,7 +17,11 @@ export * from "./sapnwrfc-throughput";
 export * from "./sapnwrfc-server";
 export * from "./sapnwrfc";
 
-import { noderfc_binding } from "./noderfc-bindings";
+import {
+    noderfc_binding,
+    NodeRfcCacheStatus,
+    NodeRfcThreadPoolStatus,
+} from "./noderfc-bindings";
 
 //
 // Addon functions
@@ -49,6 +53,29 @@ export function setLogFilePath(filePath: string) {
     noderfc_binding.setLogFilePath(filePath);
 }
 
+export function invalidateFunctionDescription(
+    rfmName: string,
+    sysId?: string
+): number {
+    return noderfc_binding.invalidateFunctionDescription(rfmName, sysId);
+}
+
+export function clearCache(sysId?: string): number {
+    return noderfc_binding.clearCache(sysId);
+}
+
+export function cacheStatus(): NodeRfcCacheStatus {
+    return noderfc_binding.cacheStatus();
+}
+
+export function setRfcThreadPoolSize(size: number) {
+    noderfc_binding.setRfcThreadPoolSize(size);
+}
+
+export function rfcThreadPoolStatus(): NodeRfcThreadPoolStatus {
+    return noderfc_binding.rfcThreadPoolStatus();
+}
+
 export const sapnwrfcEvents = new EventEmitter();
 
 export function cancelClient(
@@ -31,6 +31,20 @@ export interface NWRfcSdkError {
     message: string;
 }
 
+export interface NodeRfcCacheStatus {
+    size: number;
+    hits: number;
+    misses: number;
+}
+
+export interface NodeRfcThreadPoolStatus {
+    size: number;
+    threads: number;
+    pending: number;
+    active: number;
+    completed: number;
+}
+
 export interface NWRfcBinding {
     Client: RfcClientBinding;
     Pool: RfcPoolBinding;
@@ -44,6 +58,11 @@ export interface NWRfcBinding {
     languageSapToIso(langSap: string): string | NWRfcSdkError;
     reloadIniFile(): undefined | NWRfcSdkError;
     setLogFilePath(filePath: string): unknown;
+    invalidateFunctionDescription(rfmName: string, sysId?: string): number;
+    clearCache(sysId?: string): number;
+    cacheStatus(): NodeRfcCacheStatus;
+    setRfcThreadPoolSize(size: number): void;
+    rfcThreadPoolStatus(): NodeRfcThreadPoolStatus;
     verbose(): this;
 }
 
@@ -7,6 +7,7 @@ import {
     noderfc_binding,
     environment,
     NodeRfcEnvironment,
+    NWRfcSdkError,
 } from "./noderfc-bindings";
 
 import {
@@ -14,27 +15,60 @@ import {
     RfcLoggingLevel,
     RfcParameterDirection,
     RfcObject,
+    RfcTable,
 } from "./sapnwrfc";
 
 //
 // RfcClient
 //
 
+export type RfcDateTimePreset = "string" | "Date" | "epochMs" | "iso";
+
 export type RfcClientOptions = {
-    bcd?: string | Function;
-    date?: { toABAP: Function; fromABAP: Function };
-    time?: { toABAP: Function; fromABAP: Function };
+    bcd?: "string" | "number" | "scaledBigInt" | { scale: number } | Function;
+    date?: { toABAP: Function; fromABAP: Function } | RfcDateTimePreset;
+    time?: { toABAP: Function; fromABAP: Function } | RfcDateTimePreset;
     filter?: RfcParameterDirection;
     stateless?: boolean;
+    bigint?: boolean;
     timeout?: number;
+    table?: "rows" | "columns";
+    decoder?: "field" | "row";
     logLevel?: RfcLoggingLevel;
 };
 
+export interface RfcClientQueueStatus {
+    active: boolean;
+    pending: number;
+    maxPending: number;
+    completed: number;
+}
+
 export type RfcCallOptions = {
     notRequested?: Array<string>;
     timeout?: number;
 };
 
+export type RfcBatchCall = {
+    rfm: string;
+    params: RfcObject;
+    notRequested?: Array<string>;
+};
+
+export type RfcBatchResult = {
+    error?: unknown;
+    result?: RfcObject;
+};
+
+export type RfcStreamOptions = RfcCallOptions & {
+    chunkSize?: number;
+};
+
+export type RfcTableChunk = {
+    table: string;
+    rows: RfcTable;
+};
+
 interface RfcConnectionInfo {
     dest: string;
     host: string;
@@ -63,6 +97,13 @@ interface RfcConnectionInfo {
     //reserved: string;
 }
 
+export interface RfcTableCursorBinding {
+    result: RfcObject;
+    tables: { [key: string]: number };
+    read(table: string, count: number): RfcTable | NWRfcSdkError;
+    close(): void;
+}
+
 export type RfcClientConfig = {
     connectionParameters: RfcConnectionParameters;
     clientOptions?: RfcClientOptions;
@@ -83,6 +124,7 @@ export interface RfcClientBinding {
     _connectionHandle: number;
     _pool_id: number;
     _config: RfcClientConfig;
+    _queue: RfcClientQueueStatus;
     connectionInfo(): RfcConnectionInfo;
     open(callback: Function): void;
     close(callback: Function): void;
@@ -95,9 +137,65 @@ export interface RfcClientBinding {
         callback: Function,
         callOptions?: RfcCallOptions
     ): void;
+    invokeStream(
+        rfmName: string,
+        rfmParams: RfcObject,
+        callback: Function,
+        callOptions?: RfcCallOptions
+    ): void;
+    invokeBatch(calls: Array<RfcBatchCall>, callback: Function): void;
     release(oneClientBinding: [RfcClientBinding], callback: Function): void;
 }
 
+//
+// Table parameters of the function call result, read in chunks
+//
+
+export class RfcResultStream implements AsyncIterable<RfcTableChunk> {
+    private __cursor: RfcTableCursorBinding;
+    private __chunkSize: number;
+
+    constructor(cursor: RfcTableCursorBinding, chunkSize: number) {
+        this.__cursor = cursor;
+        this.__chunkSize = chunkSize;
+    }
+
+    // non-table parameters
+    get result(): RfcObject {
+        return this.__cursor.result;
+    }
+
+    // table names and row counts
+    get tables(): { [key: string]: number } {
+        return this.__cursor.tables;
+    }
+
+    async *[Symbol.asyncIterator](): AsyncIterator<RfcTableChunk> {
+        try {
+            for (const table of Object.keys(this.__cursor.tables)) {
+                for (;;) {
+                    const rows = this.__cursor.read(table, this.__chunkSize);
+                    if (!Array.isArray(rows)) {
+                        throw rows;
+                    }
+                    if (rows.length === 0) {
+                        break;
+                    }
+                    yield { table, rows };
+                    // let other callbacks run between chunks
+                    await new Promise((resolve) => setImmediate(resolve));
+                }
+            }
+        } finally {
+            this.close();
+        }
+    }
+
+    close() {
+        this.__cursor.close();
+    }
+}
+
 export class Client {
     private __client: RfcClientBinding;
 
@@ -152,6 +250,10 @@ export class Client {
         return this.__client._config;
     }
 
+    get queue(): RfcClientQueueStatus {
+        return this.__client._queue;
+    }
+
     get _id(): string {
         return `${this.__client._id} handle: ${
             this.__client._connectionHandle
@@ -397,6 +499,83 @@ export class Client {
         );
     }
 
+    invokeStream(
+        rfmName: string,
+        rfmParams: RfcObject,
+        streamOptions: RfcStreamOptions = {}
+    ): Promise<RfcResultStream> {
+        return new Promise((resolve, reject) => {
+            try {
+                if (typeof rfmName !== "string") {
+                    throw new TypeError(
+                        "Client invokeStream() 1st argument (remote function module name) must be an string"
+                    );
+                }
+                if (typeof rfmParams !== "object") {
+                    throw new TypeError(
+                        "Client invokeStream() 2nd argument (remote function module parameters) must be an object"
+                    );
+                }
+                if (typeof streamOptions !== "object") {
+                    throw new TypeError(
+                        "Stream options argument must be an object"
+                    );
+                }
+                const { chunkSize = 1000, ...callOptions } = streamOptions;
+                if (!Number.isInteger(chunkSize) || chunkSize < 1) {
+                    throw new TypeError(
+                        `Stream option "chunkSize" must be a positive integer, received: ${chunkSize}`
+                    );
+                }
+                this.__client.invokeStream(
+                    rfmName,
+                    rfmParams,
+                    this.timeoutCallback(
+                        (err: unknown, cursor: RfcTableCursorBinding) => {
+                            if (err !== undefined && err !== null) {
+                                reject(err);
+                            } else {
+                                resolve(new RfcResultStream(cursor, chunkSize));
+                            }
+                        },
+                        callOptions
+                    ),
+                    callOptions
+                );
+            } catch (ex) {
+                reject(ex);
+            }
+        });
+    }
+
+    private timeoutCallback(
+        callback: Function,
+        callOptions?: RfcCallOptions
+    ): Function {
+        const clientOptions = this.config.clientOptions;
+        let timeout = 0;
+        if (callOptions && callOptions.timeout) {
+            timeout = callOptions.timeout;
+        }
+        if (timeout === 0 && clientOptions && clientOptions.timeout) {
+            timeout = clientOptions.timeout;
+        }
+        if (timeout === 0) {
+            return callback;
+        }
+        const cancelTimeout = setTimeout(() => {
+            /* eslint-disable @typescript-eslint/no-unused-vars */
+            (this.cancel as Function)((_err: unknown, _res: unknown) => {
+                // _res like
+                // { connectionHandle: 140414048978432, result: 'cancelled' }
+            });
+        }, timeout * 1000);
+        return (err: unknown, res: unknown) => {
+            clearTimeout(cancelTimeout);
+            callback(err, res);
+        };
+    }
+
     invoke(
         rfmName: string,
         rfmParams: RfcObject,
@@ -430,30 +609,10 @@ export class Client {
                 throw new TypeError("Call options argument must be an object");
             }
 
-            const clientOptions = this.config.clientOptions;
-            let timeout = 0,
-                callbackFunction = callback;
-            if (callOptions && callOptions.timeout) {
-                timeout = callOptions.timeout;
-            }
-            if (timeout === 0 && clientOptions && clientOptions.timeout) {
-                timeout = clientOptions.timeout;
-            }
-            if (timeout > 0) {
-                const cancelTimeout = setTimeout(() => {
-                    /* eslint-disable @typescript-eslint/no-unused-vars */
-                    (this.cancel as Function)(
-                        (_err: unknown, _res: unknown) => {
-                            // _res like
-                            // { connectionHandle: 140414048978432, result: 'cancelled' }
-                        }
-                    );
-                }, timeout * 1000);
-                callbackFunction = (err: unknown, res: unknown) => {
-                    clearTimeout(cancelTimeout);
-                    callback(err, res);
-                };
-            }
+            const callbackFunction = this.timeoutCallback(
+                callback,
+                callOptions
+            );
 
             // check rfm parmeters' names
             for (const rfmParamName of Object.keys(rfmParams)) {
@@ -481,4 +640,47 @@ export class Client {
             }
         }
     }
+
+    invokeBatch(
+        calls: Array<RfcBatchCall>,
+        callback?: Function
+    ): void | Promise<Array<RfcBatchResult>> {
+        Client.checkCallbackArg("invokeBatch", callback);
+
+        const invokeBatch = (batchCallback: Function) => {
+            if (!Array.isArray(calls)) {
+                throw new TypeError(
+                    "Client invokeBatch() argument must be an array of {rfm, params} objects"
+                );
+            }
+            this.__client.invokeBatch(
+                calls,
+                this.timeoutCallback(batchCallback)
+            );
+        };
+
+        if (typeof callback === "function") {
+            try {
+                invokeBatch(callback);
+            } catch (ex) {
+                callback(ex);
+            }
+        } else {
+            return new Promise((resolve, reject) => {
+                try {
+                    invokeBatch(
+                        (err: unknown, res: Array<RfcBatchResult>) => {
+                            if (err === undefined || err === null) {
+                                resolve(res);
+                            } else {
+                                reject(err);
+                            }
+                        }
+                    );
+                } catch (ex) {
+                    reject(ex);
+                }
+            });
+        }
+    }
 }
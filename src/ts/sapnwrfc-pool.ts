@@ -11,7 +11,13 @@ import {
 
 import { RfcConnectionParameters, RfcLoggingLevel } from "./sapnwrfc";
 
-import { Client, RfcClientBinding, RfcClientOptions } from "./sapnwrfc-client";
+import {
+    Client,
+    RfcBatchCall,
+    RfcBatchResult,
+    RfcClientBinding,
+    RfcClientOptions,
+} from "./sapnwrfc-client";
 
 //
 // RfcPool
@@ -28,6 +34,10 @@ export interface RfcPoolStatus {
     leased: number;
 }
 
+export interface RfcParallelOptions {
+    concurrency?: number;
+}
+
 export interface RfcPoolConfiguration {
     connectionParameters: RfcConnectionParameters;
     clientOptions?: RfcClientOptions;
@@ -47,6 +57,11 @@ export interface RfcPoolBinding {
     ): void;
     ready(new_ready?: number, callback?: Function): void;
     closeAll(callback?: Function): void;
+    invokeParallel(
+        calls: Array<RfcBatchCall>,
+        options: RfcParallelOptions,
+        callback: Function
+    ): void;
     _config: {
         connectionParameters: object;
         clientOptions?: object;
@@ -297,6 +312,59 @@ export class Pool {
         }
     }
 
+    invokeParallel(
+        calls: Array<RfcBatchCall>,
+        arg2?: RfcParallelOptions | Function,
+        arg3?: Function
+    ): void | Promise<Array<RfcBatchResult>> {
+        let options: RfcParallelOptions = {};
+        let callback: Function | undefined;
+        if (typeof arg2 === "function") {
+            callback = arg2;
+        } else {
+            if (arg2 !== undefined) {
+                if (typeof arg2 !== "object" || arg2 === null) {
+                    throw new TypeError(
+                        `Pool invokeParallel() options argument must be an object, received: ${typeof arg2}`
+                    );
+                }
+                options = arg2;
+            }
+            if (arg3 !== undefined && typeof arg3 !== "function") {
+                throw new TypeError(
+                    `Pool invokeParallel() callback argument must be a function, received: ${typeof arg3}`
+                );
+            }
+            callback = arg3;
+        }
+
+        if (callback === undefined) {
+            return new Promise((resolve, reject) => {
+                try {
+                    this.__pool.invokeParallel(
+                        calls,
+                        options,
+                        (err: unknown, res: Array<RfcBatchResult>) => {
+                            if (err === undefined || err === null) {
+                                resolve(res);
+                            } else {
+                                reject(err);
+                            }
+                        }
+                    );
+                } catch (ex) {
+                    reject(ex);
+                }
+            });
+        }
+
+        try {
+            this.__pool.invokeParallel(calls, options, callback);
+        } catch (ex) {
+            callback(ex);
+        }
+    }
+
     get id(): Object {
         return this.__pool._id;
     }
@@ -206,6 +206,7 @@ export type RfcConnectionParameters = Partial<
 export type RfcVariable =
     | string
     | number
+    | bigint
     | Buffer
     | Date
     | Decimal
@@ -219,11 +220,20 @@ export type RfcStructure = {
 export type RfcTable = Array<RfcVariable | RfcStructure>;
 export type RfcTableOfVariables = Array<RfcVariable>;
 export type RfcTableOfStructures = Array<RfcStructure>;
+export type RfcColumn =
+    | Int32Array
+    | Float64Array
+    | Buffer
+    | ArrayBufferView
+    | RfcTable;
+export type RfcTableColumns = { [key: string]: RfcColumn };
 export type RfcParameterValue =
     | RfcVariable
     | RfcArray
     | RfcStructure
-    | RfcTable;
+    | RfcTable
+    | RfcColumn
+    | RfcTableColumns;
 export type RfcObject = { [key: string]: RfcParameterValue };
 
 // Logging options
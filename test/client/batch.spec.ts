@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { direct_client, RfcBatchResult } from "../utils/setup";
+
+describe("Client: invokeBatch()", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Results returned in call order", async () => {
+        const CALLS = 20;
+        expect.assertions(CALLS + 1);
+        const results = (await client.invokeBatch(
+            [...Array(CALLS).keys()].map((i) => ({
+                rfm: "STFC_CONNECTION",
+                params: { REQUTEXT: `call ${i}` },
+            }))
+        )) as RfcBatchResult[];
+        expect(results.length).toBe(CALLS);
+        results.forEach((item, i) => {
+            expect(item.result?.ECHOTEXT).toBe(`call ${i}`);
+        });
+    });
+
+    test("Failed call does not stop the batch", async () => {
+        expect.assertions(4);
+        const results = (await client.invokeBatch([
+            { rfm: "STFC_CONNECTION", params: { REQUTEXT: "first" } },
+            { rfm: "STFC_CONNECTION", params: { XXX: "wrong param" } },
+            { rfm: "STFC_CONNECTION", params: { REQUTEXT: "last" } },
+        ])) as RfcBatchResult[];
+        expect(results[0].result?.ECHOTEXT).toBe("first");
+        expect(results[1].result).toBeUndefined();
+        expect(results[1].error).toEqual(
+            expect.objectContaining({
+                code: 20,
+                key: "RFC_INVALID_PARAMETER",
+                message: "field 'XXX' not found",
+            })
+        );
+        expect(results[2].result?.ECHOTEXT).toBe("last");
+    });
+
+    test("Not requested parameters and callback", (done) => {
+        expect.assertions(3);
+        client.invokeBatch(
+            [
+                {
+                    rfm: "STFC_CONNECTION",
+                    params: { REQUTEXT: "text" },
+                    notRequested: ["RESPTEXT"],
+                },
+            ],
+            (err: unknown, results: RfcBatchResult[]) => {
+                expect(err).toBeUndefined();
+                expect(results[0].result?.ECHOTEXT).toBe("text");
+                expect(results[0].result?.RESPTEXT).toBe("");
+                done();
+            }
+        );
+    });
+
+    test("Calls array checked", async () => {
+        expect.assertions(1);
+        await expect(
+            client.invokeBatch([{ params: {} }] as unknown as [])
+        ).rejects.toThrow(
+            new TypeError(
+                "Client invokeBatch() requires an array of {rfm, params} objects"
+            )
+        );
+    });
+});
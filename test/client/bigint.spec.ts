@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { direct_client, RfcStructure } from "../utils/setup";
+
+describe('Client: INT8 conversion option "bigint"', () => {
+    const client = direct_client("MME", { bigint: true });
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Option set in client config", () => {
+        expect.assertions(2);
+        expect(client.config.clientOptions?.bigint).toBe(true);
+        expect(direct_client().config.clientOptions?.bigint).toBe(false);
+    });
+
+    test("BigInt accepted for integer fields", async () => {
+        expect.assertions(2);
+        const res = await client.call("STFC_STRUCTURE", {
+            IMPORTSTRUCT: { RFCINT1: BigInt(7), RFCINT4: BigInt(-2147483648) },
+        });
+        const echo = res.ECHOSTRUCT as RfcStructure;
+        // INT, INT1 and INT2 always returned as Number
+        expect(echo.RFCINT1).toBe(7);
+        expect(echo.RFCINT4).toBe(-2147483648);
+    });
+
+    test("BigInt out of integer field range rejected", async () => {
+        expect.assertions(1);
+        await expect(
+            client.call("STFC_STRUCTURE", {
+                IMPORTSTRUCT: { RFCINT4: BigInt(2147483648) },
+            })
+        ).rejects.toMatchObject({
+            name: "nodeRfcError",
+            message:
+                "Overflow or other error when putting NodeJS value 2147483648 into ABAP integer field of type 8",
+        });
+    });
+
+    test("BigInt table of elementary lines", async () => {
+        expect.assertions(1);
+        const lines = [
+            BigInt(0),
+            BigInt(-1),
+            BigInt("9223372036854775807"),
+            BigInt("-9223372036854775808"),
+        ];
+        // INT8 line type table
+        const res = await client.call("/COE/RBP_FE_DATATYPES", {
+            IT_INT8: lines,
+        });
+        expect(res.ET_INT8).toEqual(lines);
+    });
+
+    test("BigInt line of non-integer elementary table rejected", async () => {
+        expect.assertions(1);
+        // RAW16 line type table
+        await expect(
+            client.call("/COE/RBP_FE_DATATYPES", {
+                IT_SXMSMGUIDT: [BigInt(1)],
+            })
+        ).rejects.toMatchObject({
+            name: "nodeRfcError",
+            message: "Buffer expected from NodeJS for ABAP field of type 4",
+        });
+    });
+
+    test("INT8 table column returned as BigInt64Array", async () => {
+        expect.assertions(2);
+        const lines = BigInt64Array.from([BigInt(1), BigInt(-2)]);
+        const columnsClient = direct_client("MME", {
+            bigint: true,
+            table: "columns",
+        });
+        await columnsClient.open();
+        try {
+            const res = await columnsClient.call("/COE/RBP_FE_DATATYPES", {
+                IT_INT8: Array.from(lines),
+            });
+            expect(res.ET_INT8).toBeInstanceOf(BigInt64Array);
+            expect(res.ET_INT8).toEqual(lines);
+        } finally {
+            await columnsClient.close();
+        }
+    });
+
+    test("Bigint option value checked", () => {
+        expect.assertions(1);
+        expect(() =>
+            direct_client("MME", { bigint: "true" as unknown as boolean })
+        ).toThrow(
+            new TypeError('Client option "bigint" requires a boolean value')
+        );
+    });
+});
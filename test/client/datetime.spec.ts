@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import {
+    direct_client,
+    RfcClientOptions,
+    RfcStructure,
+    RfcTable,
+} from "../utils/setup";
+
+describe('Client: date and time presets of options "date" and "time"', () => {
+    async function echo(options: RfcClientOptions, input: RfcStructure) {
+        const client = direct_client("MME", options);
+        await client.open();
+        try {
+            const res = await client.call("STFC_STRUCTURE", {
+                IMPORTSTRUCT: input,
+                RFCTABLE: [input],
+            });
+            return {
+                struct: res.ECHOSTRUCT as RfcStructure,
+                row: (res.RFCTABLE as RfcTable)[0] as RfcStructure,
+            };
+        } finally {
+            await client.close();
+        }
+    }
+
+    test("Date objects", async () => {
+        expect.assertions(4);
+        const date = new Date(Date.UTC(2024, 1, 29));
+        const time = new Date(Date.UTC(1970, 0, 1, 23, 59, 58));
+        const res = await echo(
+            { date: "Date", time: "Date" },
+            { RFCDATE: date, RFCTIME: time }
+        );
+        expect(res.struct.RFCDATE).toEqual(date);
+        expect(res.struct.RFCTIME).toEqual(time);
+        expect(res.row.RFCDATE).toEqual(date);
+        expect(res.row.RFCTIME).toEqual(time);
+    });
+
+    test("Epoch milliseconds", async () => {
+        expect.assertions(2);
+        const res = await echo(
+            { date: "epochMs", time: "epochMs" },
+            { RFCDATE: Date.UTC(1999, 11, 31), RFCTIME: 3723000 }
+        );
+        expect(res.struct.RFCDATE).toEqual(Date.UTC(1999, 11, 31));
+        expect(res.struct.RFCTIME).toEqual(3723000);
+    });
+
+    test("ISO strings", async () => {
+        expect.assertions(2);
+        const res = await echo(
+            { date: "iso", time: "iso" },
+            { RFCDATE: "2024-01-31", RFCTIME: "120000" }
+        );
+        expect(res.struct.RFCDATE).toEqual("2024-01-31");
+        expect(res.struct.RFCTIME).toEqual("12:00:00");
+    });
+
+    test("Initial date returned as null", async () => {
+        expect.assertions(2);
+        const res = await echo(
+            { date: "Date", time: "iso" },
+            { RFCDATE: null, RFCTIME: null } as unknown as RfcStructure
+        );
+        expect(res.struct.RFCDATE).toBeNull();
+        expect(res.struct.RFCTIME).toEqual("00:00:00");
+    });
+
+    test("Date and time tables of elementary lines", async () => {
+        expect.assertions(2);
+        const dates = [new Date(Date.UTC(2024, 1, 29)), null];
+        const times = [new Date(Date.UTC(1970, 0, 1, 12, 30, 15))];
+        const client = direct_client("MME", { date: "Date", time: "Date" });
+        await client.open();
+        try {
+            // DATS and TIMS line type tables
+            const res = await client.call("/COE/RBP_FE_DATATYPES", {
+                IT_DATS: dates,
+                IT_TIMS: times,
+            });
+            expect(res.ET_DATS).toEqual(dates);
+            expect(res.ET_TIMS).toEqual(times);
+        } finally {
+            await client.close();
+        }
+    });
+
+    test("Date line not matching the preset rejected", async () => {
+        expect.assertions(1);
+        const client = direct_client("MME", { date: "epochMs" });
+        await client.open();
+        try {
+            await expect(
+                client.call("/COE/RBP_FE_DATATYPES", {
+                    IT_DATS: [new Date()],
+                })
+            ).rejects.toMatchObject({
+                name: "nodeRfcError",
+                message:
+                    "Date as epochMs expected from NodeJS for ABAP field of type 1",
+            });
+        } finally {
+            await client.close();
+        }
+    });
+
+    test("Value not matching the preset rejected", async () => {
+        expect.assertions(1);
+        await expect(
+            echo({ date: "epochMs" }, { RFCDATE: new Date() })
+        ).rejects.toMatchObject({
+            name: "nodeRfcError",
+            message:
+                "Date as epochMs expected from NodeJS for ABAP field of type 1",
+        });
+    });
+
+    test("Preset value checked", () => {
+        expect.assertions(1);
+        expect(() =>
+            direct_client("MME", { date: "Dates" as "Date" })
+        ).toThrow(
+            new TypeError('Client option "date" value not allowed: "Dates"')
+        );
+    });
+});
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import {
+    direct_client,
+    Client,
+    RfcClientOptions,
+    RfcLoggingLevel,
+    RfcObject,
+    RfcTable,
+} from "../utils/setup";
+
+type StreamedResult = { result: RfcObject; tables: Record<string, RfcTable> };
+
+describe('Client: row decoder option "decoder"', () => {
+    const fieldClient = direct_client("MME", {
+        logLevel: RfcLoggingLevel.none,
+        decoder: "field",
+    });
+    const rowClient = direct_client("MME", {
+        logLevel: RfcLoggingLevel.none,
+        decoder: "row",
+    });
+
+    beforeAll(() => {
+        return Promise.all([fieldClient.open(), rowClient.open()]);
+    });
+
+    afterAll(() => {
+        return Promise.all([fieldClient.close(), rowClient.close()]);
+    });
+
+    async function streamed(
+        client: Client,
+        rfmName: string,
+        rfmParams: RfcObject
+    ): Promise<StreamedResult> {
+        const stream = await client.invokeStream(rfmName, rfmParams, {
+            chunkSize: 500,
+        });
+        const tables = {} as Record<string, RfcTable>;
+        for await (const chunk of stream) {
+            tables[chunk.table] = (tables[chunk.table] || []).concat(
+                chunk.rows
+            );
+        }
+        return { result: stream.result, tables: tables };
+    }
+
+    async function compare(rfmName: string, rfmParams: RfcObject) {
+        const byField = await streamed(fieldClient, rfmName, rfmParams);
+        const byRow = await streamed(rowClient, rfmName, rfmParams);
+        expect(byRow).toEqual(byField);
+        return byRow;
+    }
+
+    test("Mixed flat structure and table", async () => {
+        expect.assertions(3);
+        const res = await compare("STFC_STRUCTURE", {
+            IMPORTSTRUCT: {
+                RFCINT1: 1,
+                RFCINT2: -2,
+                RFCINT4: 3,
+                RFCFLOAT: 1.5,
+                RFCCHAR4: "ABCD",
+                RFCHEX3: Buffer.from("0a0b0c", "hex"),
+                RFCDATE: "20231231",
+                RFCTIME: "235959",
+            },
+            RFCTABLE: [
+                { RFCINT4: 1, RFCCHAR4: "A", RFCDATE: "20240101" },
+                { RFCINT4: 2, RFCCHAR4: "Ä€", RFCTIME: "120000" },
+            ],
+        });
+        expect(res.tables.RFCTABLE.length).toBeGreaterThan(2);
+        expect(res.result.ECHOSTRUCT).toBeDefined();
+    });
+
+    test("Char-like table", async () => {
+        expect.assertions(2);
+        const res = await compare("STFC_PERFORMANCE", {
+            CHECKTAB: "X",
+            LGET0332: "3000",
+            LGET1000: "1000",
+        });
+        expect(res.tables.ETAB0332.length).toEqual(3000);
+    }, 60000);
+
+    test("Char-like table with NUM fields", async () => {
+        expect.assertions(2);
+        const res = await compare("RFC_READ_TABLE", {
+            QUERY_TABLE: "T000",
+            DELIMITER: "|",
+        });
+        expect(res.tables.FIELDS.length).toBeGreaterThan(0);
+    });
+
+    test("Date and time conversion functions applied", async () => {
+        expect.assertions(2);
+        const options = {
+            logLevel: RfcLoggingLevel.none,
+            date: { fromABAP: (d: string) => `D${d}` },
+            time: { fromABAP: (t: string) => `T${t}` },
+        } as RfcClientOptions;
+        const fieldDates = direct_client("MME", {
+            ...options,
+            decoder: "field",
+        });
+        const rowDates = direct_client("MME", { ...options, decoder: "row" });
+        await Promise.all([fieldDates.open(), rowDates.open()]);
+        const params = {
+            RFCTABLE: [{ RFCDATE: "20240229", RFCTIME: "010203" }],
+        };
+        const byField = await streamed(fieldDates, "STFC_STRUCTURE", params);
+        const byRow = await streamed(rowDates, "STFC_STRUCTURE", params);
+        await Promise.all([fieldDates.close(), rowDates.close()]);
+        expect(byRow).toEqual(byField);
+        expect(byRow.tables.RFCTABLE[0]).toMatchObject({
+            RFCDATE: "D20240229",
+            RFCTIME: "T010203",
+        });
+    });
+
+    test("Decoder option value checked", () => {
+        expect.assertions(1);
+        expect(() =>
+            direct_client("MME", { decoder: "rows" as "row" })
+        ).toThrow(
+            new TypeError('Client option "decoder" value not allowed: "rows"')
+        );
+    });
+
+    test("Decoder option not coerced to string", () => {
+        expect.assertions(1);
+        const decoder = { toString: () => "row" } as unknown as "row";
+        expect(() => direct_client("MME", { decoder })).toThrow(
+            new TypeError('Client option "decoder" value not allowed: "object"')
+        );
+    });
+});
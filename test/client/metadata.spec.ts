@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { direct_client, addon, abapSystem, Client } from "../utils/setup";
+
+describe("Client: function descriptions cache", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        addon.clearCache();
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Repeated call reads function description from cache", async () => {
+        expect.assertions(3);
+        await client.call("STFC_CONNECTION", { REQUTEXT: "cold" });
+        const cold = addon.cacheStatus();
+        await client.call("STFC_CONNECTION", { REQUTEXT: "warm" });
+        const warm = addon.cacheStatus();
+        expect(cold.size).toEqual(1);
+        expect(warm.hits).toEqual(cold.hits + 1);
+        expect(warm.misses).toEqual(cold.misses);
+    });
+
+    test("Cache shared between clients", async () => {
+        expect.assertions(2);
+        const client2 = direct_client();
+        await client2.open();
+        const before = addon.cacheStatus();
+        await client2.call("STFC_CONNECTION", { REQUTEXT: "shared" });
+        const after = addon.cacheStatus();
+        await client2.close();
+        expect(after.hits).toEqual(before.hits + 1);
+        expect(after.size).toEqual(before.size);
+    });
+
+    test("invalidateFunctionDescription() removes the function description", async () => {
+        expect.assertions(4);
+        expect(addon.invalidateFunctionDescription("STFC_CONNECTION")).toEqual(
+            1
+        );
+        expect(addon.invalidateFunctionDescription("STFC_CONNECTION")).toEqual(
+            0
+        );
+        const before = addon.cacheStatus();
+        const result = await client.call("STFC_CONNECTION", {
+            REQUTEXT: "invalidated",
+        });
+        expect(result.ECHOTEXT).toEqual("invalidated");
+        expect(addon.cacheStatus().misses).toEqual(before.misses + 1);
+    });
+
+    test("invalidateFunctionDescription() while calls queued", async () => {
+        expect.assertions(4);
+        await client.call("STFC_CONNECTION", { REQUTEXT: "cached" });
+        // second call queued, holding the cached function description
+        const calls = [
+            client.call("RFC_PING_AND_WAIT", { SECONDS: 1 }),
+            client.call("STFC_CONNECTION", { REQUTEXT: "queued" }),
+        ];
+        expect(addon.invalidateFunctionDescription("STFC_CONNECTION")).toEqual(
+            1
+        );
+        const results = await Promise.all(calls);
+        expect(results[1].ECHOTEXT).toEqual("queued");
+        const before = addon.cacheStatus();
+        const result = await client.call("STFC_CONNECTION", {
+            REQUTEXT: "reloaded",
+        });
+        expect(result.ECHOTEXT).toEqual("reloaded");
+        expect(addon.cacheStatus().misses).toEqual(before.misses + 1);
+    });
+
+    test("invalidateFunctionDescription() with two ABAP clients of one system", async () => {
+        expect.assertions(5);
+        // same system, other ABAP client: own cache entry, same SDK descriptor
+        const client000 = new Client({ ...abapSystem(), client: "000" });
+        await client000.open();
+        await client.call("STFC_CONNECTION", { REQUTEXT: "cached" });
+        await client000.call("STFC_CONNECTION", { REQUTEXT: "cached" });
+        expect(addon.cacheStatus().size).toBeGreaterThanOrEqual(2);
+
+        // calls in flight on both clients, holding the shared descriptor
+        const calls = [
+            client.call("RFC_PING_AND_WAIT", { SECONDS: 1 }),
+            client.call("STFC_CONNECTION", { REQUTEXT: "queued" }),
+            client000.call("RFC_PING_AND_WAIT", { SECONDS: 2 }),
+            client000.call("STFC_CONNECTION", { REQUTEXT: "queued 000" }),
+        ];
+        expect(addon.invalidateFunctionDescription("STFC_CONNECTION")).toEqual(
+            2
+        );
+        const results = await Promise.all(calls);
+        expect(results[1].ECHOTEXT).toEqual("queued");
+        expect(results[3].ECHOTEXT).toEqual("queued 000");
+        const result = await client000.call("STFC_CONNECTION", {
+            REQUTEXT: "reloaded",
+        });
+        await client000.close();
+        expect(result.ECHOTEXT).toEqual("reloaded");
+    });
+
+    test("clearCache() removes all function descriptions", async () => {
+        expect.assertions(2);
+        await client.call("STFC_STRUCTURE", {});
+        expect(addon.clearCache()).toBeGreaterThanOrEqual(2);
+        expect(addon.cacheStatus().size).toEqual(0);
+    });
+
+    test("invalidateFunctionDescription() requires RFM name string", () => {
+        expect.assertions(1);
+        expect(() =>
+            addon.invalidateFunctionDescription(1 as unknown as string)
+        ).toThrow(
+            new TypeError(
+                "invalidateFunctionDescription() requires the RFM name string"
+            )
+        );
+    });
+});
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { direct_client, RfcObject, RfcStructure } from "../utils/setup";
+
+describe("Client: operations queue", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Queue idle after open", () => {
+        expect.assertions(2);
+        expect(client.queue.active).toBe(false);
+        expect(client.queue.pending).toBe(0);
+    });
+
+    test("Concurrent calls queued and completed in order", async () => {
+        const CALLS = 8;
+        expect.assertions(CALLS + 4);
+        const completed = client.queue.completed;
+        const order: number[] = [];
+        const calls: Promise<RfcObject>[] = [];
+        for (let i = 0; i < CALLS; i++) {
+            calls.push(
+                client
+                    .call("STFC_CONNECTION", { REQUTEXT: `call ${i}` })
+                    .then((res) => {
+                        order.push(i);
+                        return res;
+                    })
+            );
+        }
+        // first call running, the rest waiting in the queue
+        expect(client.queue.pending).toBe(CALLS - 1);
+        const results = await Promise.all(calls);
+        results.forEach((res, i) => {
+            expect(res.ECHOTEXT).toBe(`call ${i}`);
+        });
+        expect(order).toEqual([...Array(CALLS).keys()]);
+        expect(client.queue.maxPending).toBeGreaterThanOrEqual(CALLS - 1);
+        expect(client.queue.completed).toBe(completed + CALLS);
+    });
+
+    test("Parameter error of cached call returned in order", async () => {
+        expect.assertions(4);
+        let conversions = 0;
+        const xclient = direct_client("MME", {
+            date: {
+                toABAP: (date: unknown) => {
+                    conversions++;
+                    return date;
+                },
+                fromABAP: (date: string) => date,
+            },
+        });
+        await xclient.open();
+        // function description cached by the first call
+        await xclient.call("STFC_STRUCTURE", {});
+        const order: string[] = [];
+        const first = xclient
+            .call("STFC_CONNECTION", { REQUTEXT: "first" })
+            .then(() => order.push("first"));
+        const invalid = xclient
+            .call("STFC_STRUCTURE", {
+                IMPORTSTRUCT: { RFCDATE: 20240101 } as RfcStructure,
+            })
+            .catch((err: unknown) => {
+                order.push("invalid");
+                return err;
+            });
+        const err = (await invalid) as Error;
+        await first;
+        await xclient.close();
+        expect(err.message).toBe(
+            "Date format YYYYMMDD expected from NodeJS for ABAP field of type 1"
+        );
+        expect(order).toEqual(["first", "invalid"]);
+        // parameters converted once
+        expect(conversions).toBe(1);
+        expect(xclient.queue.pending).toBe(0);
+    });
+
+    test("Ping queued behind call", async () => {
+        expect.assertions(3);
+        const call = client.call("STFC_CONNECTION", { REQUTEXT: "first" });
+        const ping = client.ping();
+        expect(client.queue.pending).toBe(1);
+        const [res, pong] = await Promise.all([call, ping]);
+        expect(res.ECHOTEXT).toBe("first");
+        expect(pong).toBe(true);
+    });
+});
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import Decimal from "decimal.js";
+import { direct_client, RfcTable, RfcStructure } from "../utils/setup";
+
+describe("Client: invokeStream()", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Table rows streamed in chunks", async () => {
+        const COUNT = 10000;
+        const CHUNK = 999;
+        expect.assertions(5);
+        const stream = await client.invokeStream(
+            "STFC_PERFORMANCE",
+            { CHECKTAB: "X", LGET0332: COUNT.toString(), LGET1000: "0" },
+            { chunkSize: CHUNK }
+        );
+        expect(stream.result.EXITCODE).toBeDefined();
+        expect(stream.tables.ETAB0332).toEqual(COUNT);
+        let rows = 0,
+            chunks = 0;
+        for await (const chunk of stream) {
+            if (chunk.table === "ETAB0332") {
+                expect(chunk.rows.length).toBeLessThanOrEqual(CHUNK);
+                rows += chunk.rows.length;
+                chunks++;
+            }
+        }
+        expect(rows).toEqual(COUNT);
+        expect(chunks).toEqual(Math.ceil(COUNT / CHUNK));
+    }, 60000);
+
+    test("Streamed rows equal call() result", async () => {
+        expect.assertions(2);
+        const params = {
+            RFCTABLE: [
+                { RFCINT4: 1, RFCCHAR4: "A" },
+                { RFCINT4: 2, RFCCHAR4: "B" },
+            ],
+        };
+        const res = await client.call("STFC_STRUCTURE", params);
+        const stream = await client.invokeStream("STFC_STRUCTURE", params);
+        const rows = [] as RfcTable;
+        for await (const chunk of stream) {
+            rows.push(...chunk.rows);
+        }
+        expect(stream.result.ECHOSTRUCT).toEqual(res.ECHOSTRUCT);
+        expect(rows.map((row) => (row as RfcStructure).RFCINT4)).toEqual(
+            (res.RFCTABLE as RfcTable).map(
+                (row) => (row as RfcStructure).RFCINT4
+            )
+        );
+    });
+
+    test("Client available while the stream is read", async () => {
+        expect.assertions(2);
+        const stream = await client.invokeStream(
+            "STFC_PERFORMANCE",
+            { CHECKTAB: "X", LGET0332: "5000", LGET1000: "0" },
+            { chunkSize: 100 }
+        );
+        const iterator = stream[Symbol.asyncIterator]();
+        await iterator.next();
+        const res = await client.call("STFC_CONNECTION", {
+            REQUTEXT: "concurrent",
+        });
+        expect(res.ECHOTEXT).toEqual("concurrent");
+        await iterator.return?.();
+        expect(stream.tables).toEqual({});
+    }, 60000);
+
+    test("bcd conversion function used for streamed results", async () => {
+        expect.assertions(2);
+        const decimalClient = direct_client("MME", { bcd: Decimal });
+        await decimalClient.open();
+        const stream = await decimalClient.invokeStream(
+            "/COE/RBP_FE_DATATYPES",
+            { IS_INPUT: { ZDEC: "12345.67", ZDECF34_MIN: "54321.76" } }
+        );
+        // table rows, if any, converted by the cursor with the same options
+        const rows = [] as RfcTable;
+        for await (const chunk of stream) {
+            rows.push(...chunk.rows);
+        }
+        await decimalClient.close();
+        const output = stream.result.ES_OUTPUT as RfcStructure;
+        expect(output.ZDEC).toEqual(new Decimal("12345.67"));
+        expect(output.ZDECF34_MIN).toEqual(new Decimal("54321.76"));
+    });
+
+    test("chunkSize option checked", async () => {
+        expect.assertions(1);
+        await expect(
+            client.invokeStream("STFC_CONNECTION", {}, { chunkSize: 0 })
+        ).rejects.toThrow(
+            new TypeError(
+                'Stream option "chunkSize" must be a positive integer, received: 0'
+            )
+        );
+    });
+});
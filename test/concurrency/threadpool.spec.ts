@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import fs from "fs";
+import { addon, direct_client, Client } from "../utils/setup";
+
+describe("Concurrency: RFC threadpool", () => {
+    const WAIT_SECONDS = 2;
+    const TEST_TIMEOUT = 20000;
+
+    afterAll(() => {
+        addon.setRfcThreadPoolSize(4);
+    });
+
+    test("Threadpool size checked", () => {
+        expect.assertions(2);
+        const error = new TypeError(
+            "setRfcThreadPoolSize() requires an integer from 0 to 128"
+        );
+        expect(() => addon.setRfcThreadPoolSize(-1)).toThrow(error);
+        expect(() => addon.setRfcThreadPoolSize(1.5)).toThrow(error);
+    });
+
+    test(
+        "Slow RFC calls do not block libuv threadpool",
+        async () => {
+            const CALLS = 8;
+            expect.assertions(4);
+            addon.setRfcThreadPoolSize(CALLS);
+            const clients = await Promise.all(
+                [...Array(CALLS).keys()].map(
+                    () => direct_client().open() as Promise<Client>
+                )
+            );
+            const start = Date.now();
+            const calls = clients.map((client) =>
+                client.call("RFC_PING_AND_WAIT", { SECONDS: WAIT_SECONDS })
+            );
+            // libuv threadpool free for fs, while all clients wait in ABAP
+            await fs.promises.readFile(__filename);
+            expect(Date.now() - start).toBeLessThan(WAIT_SECONDS * 1000);
+            const status = addon.rfcThreadPoolStatus();
+            expect(status.size).toBe(CALLS);
+            expect(status.active).toBe(CALLS);
+            await Promise.all(calls);
+            await Promise.all(clients.map((client) => client.close()));
+            expect(addon.rfcThreadPoolStatus().active).toBe(0);
+        },
+        TEST_TIMEOUT
+    );
+
+    test("Cached function description call in one job", async () => {
+        expect.assertions(2);
+        const client = direct_client();
+        await client.open();
+        // first call reads the function description in separate job
+        await client.call("STFC_CONNECTION", { REQUTEXT: "first" });
+        const completed = addon.rfcThreadPoolStatus().completed;
+        const result = await client.call("STFC_CONNECTION", {
+            REQUTEXT: "cached",
+        });
+        expect(result.ECHOTEXT).toBe("cached");
+        expect(addon.rfcThreadPoolStatus().completed).toBe(completed + 1);
+        await client.close();
+    });
+
+    test("Libuv threadpool used when size set to 0", async () => {
+        expect.assertions(2);
+        addon.setRfcThreadPoolSize(0);
+        const completed = addon.rfcThreadPoolStatus().completed;
+        const client = direct_client();
+        await client.open();
+        expect(await client.ping()).toBe(true);
+        await client.close();
+        expect(addon.rfcThreadPoolStatus().completed).toBe(completed);
+    });
+});
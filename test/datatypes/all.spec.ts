@@ -130,7 +130,7 @@ describe("Datatypes: all", () => {
                 expect(err).toEqual(
                     expect.objectContaining({
                         message:
-                            "Array expected from NodeJS, for ABAP RFM table of type 5",
+                            "Array or object of columns expected from NodeJS, for ABAP RFM table of type 5",
                         name: "nodeRfcError",
                         rfmPath: {
                             parameter: "OPTIONS",
@@ -193,6 +193,74 @@ describe("Datatypes: all", () => {
         });
     });
 
+    test("DECF34 keeps all digits of numbers", async () => {
+        expect.assertions(4);
+        const isInput = {
+            ZDECF34_MIN: 0.1 + 0.2,
+            ZDECF34_MAX: -1.5e-7,
+        };
+        const xclient = direct_client("MME", { bcd: "number" });
+        await xclient.open();
+        const res = await xclient.call("/COE/RBP_FE_DATATYPES", {
+            IS_INPUT: isInput,
+        });
+        await xclient.close();
+        const es_output = res.ES_OUTPUT as RfcStructure;
+        for (const [k, inVal] of Object.entries(isInput)) {
+            expect(typeof es_output[k]).toEqual("number");
+            expect(es_output[k]).toEqual(inVal);
+        }
+    });
+
+    test("BCD returned as scaled BigInt", async () => {
+        expect.assertions(5);
+        const xclient = direct_client("MME", { bcd: "scaledBigInt" });
+        expect(xclient.config.clientOptions?.bcd).toEqual("scaledBigInt");
+        await xclient.open();
+        const res = await xclient.call("/COE/RBP_FE_DATATYPES", {
+            IS_INPUT: {
+                // scaled by ABAP field decimals
+                ZDEC: BigInt(1234567),
+                ZCURR: "-1234.56",
+            },
+        });
+        await xclient.close();
+        const es_output = res.ES_OUTPUT as RfcStructure;
+        expect(typeof es_output.ZDEC).toEqual("bigint");
+        expect(es_output.ZDEC).toEqual(BigInt(1234567));
+        expect(typeof es_output.ZCURR).toEqual("bigint");
+        expect(es_output.ZCURR).toEqual(BigInt(-123456));
+    });
+
+    test("BCD returned as BigInt with fixed scale", async () => {
+        expect.assertions(3);
+        const xclient = direct_client("MME", { bcd: { scale: 4 } });
+        expect(xclient.config.clientOptions?.bcd).toEqual({ scale: 4 });
+        await xclient.open();
+        const res = await xclient.call("/COE/RBP_FE_DATATYPES", {
+            IS_INPUT: {
+                ZDEC: "12345.67",
+                ZDECF34_MIN: BigInt("123456789012345678901234567890"),
+            },
+        });
+        await xclient.close();
+        const es_output = res.ES_OUTPUT as RfcStructure;
+        expect(es_output.ZDEC).toEqual(BigInt(123456700));
+        expect(es_output.ZDECF34_MIN).toEqual(
+            BigInt("123456789012345678901234567890")
+        );
+    });
+
+    test("BCD scale option value checked", () => {
+        expect.assertions(2);
+        expect(() => direct_client("MME", { bcd: { scale: 35 } })).toThrow(
+            new TypeError('Client option "bcd" scale not allowed: "35"')
+        );
+        expect(() => direct_client("MME", { bcd: "bigint" })).toThrow(
+            new TypeError('Client option "bcd" value not allowed: "bigint"')
+        );
+    });
+
     test("BCD and FLOAT accept strings", function (done) {
         const isInput = {
             // Float
@@ -790,6 +858,53 @@ describe("Datatypes: all", () => {
         );
     });
 
+    test("error: FLOAT not a number", function (done) {
+        const importStruct = {
+            RFCFLOAT: Number.NaN,
+        };
+        client.invoke(
+            "STFC_STRUCTURE",
+            {
+                IMPORTSTRUCT: importStruct,
+            },
+            function (err: unknown) {
+                expect(err).toEqual(
+                    expect.objectContaining({
+                        message:
+                            "Finite number expected from NodeJS for ABAP field of type 7, got NaN",
+                        name: "nodeRfcError",
+                        rfmPath: {
+                            field: "RFCFLOAT",
+                            parameter: "IMPORTSTRUCT",
+                            rfm: "STFC_STRUCTURE",
+                            structure: "IMPORTSTRUCT",
+                        },
+                    })
+                );
+                done();
+            }
+        );
+    });
+
+    test("error: DECF16 negative infinity", function (done) {
+        client.invoke(
+            "/COE/RBP_FE_DATATYPES",
+            {
+                IS_INPUT: { ZDECF16_MIN: Number.NEGATIVE_INFINITY },
+            },
+            function (err: unknown) {
+                expect(err).toEqual(
+                    expect.objectContaining({
+                        message:
+                            "Finite number expected from NodeJS for ABAP field of type 23, got -Infinity",
+                        name: "nodeRfcError",
+                    })
+                );
+                done();
+            }
+        );
+    });
+
     test("INT max positive", function (done) {
         const importStruct = {
             RFCINT1: 254,
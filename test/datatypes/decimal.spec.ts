@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import Decimal from "decimal.js";
+import {
+    direct_client,
+    Client,
+    RfcClientOptions,
+    RfcStructure,
+} from "../utils/setup";
+import { RFC_MATH } from "../utils/config";
+
+describe("Datatypes: decimal conversion edge cases", () => {
+    const clients: Client[] = [];
+
+    async function echo(
+        options: RfcClientOptions,
+        isInput: object
+    ): Promise<RfcStructure> {
+        const client = direct_client("MME", options);
+        clients.push(client);
+        await client.open();
+        const res = await client.call("/COE/RBP_FE_DATATYPES", {
+            IS_INPUT: isInput,
+        });
+        return res.ES_OUTPUT as RfcStructure;
+    }
+
+    afterAll(() => {
+        return Promise.all(
+            clients.filter((c) => c.alive).map((c) => c.close())
+        );
+    });
+
+    test("numbers sent as 15, 16 or 17 significant digits", async () => {
+        // DECF34 keeps all digits sent, read back unchanged by Decimal
+        const numbers: [number, string][] = [
+            [0.1, "0.1"],
+            [123456789012345, "123456789012345"],
+            [1 / 3, "0.3333333333333333"],
+            [0.1 + 0.2, "0.30000000000000004"],
+            [2 / 3, "0.6666666666666666"],
+            [Number.MAX_VALUE, "1.7976931348623157e+308"],
+            [Number.MIN_VALUE, "5e-324"],
+        ];
+        expect.assertions(2 * numbers.length);
+        for (const [number, digits] of numbers) {
+            const output = await echo(
+                { bcd: Decimal },
+                { ZDECF34_MIN: number }
+            );
+            expect(
+                (output.ZDECF34_MIN as Decimal).equals(new Decimal(digits))
+            ).toBe(true);
+            // same digits as NodeJS
+            expect(String(number)).toEqual(digits);
+        }
+    });
+
+    test("numbers formatted as integer, fraction or exponent", async () => {
+        const numbers = [
+            123456789012345680000, 1e21, 1.5e-6, 1.5e-7, -0.000001, -1e-7,
+            1e300, -2.5e-300,
+        ];
+        expect.assertions(numbers.length);
+        for (const number of numbers) {
+            const output = await echo(
+                { bcd: "number" },
+                { ZDECF34_MIN: number }
+            );
+            expect(output.ZDECF34_MIN).toEqual(number);
+        }
+    });
+
+    test("negative zero", async () => {
+        expect.assertions(4);
+        let output = await echo(
+            { bcd: "number" },
+            { ZDECF16_MIN: -0, ZDECF34_MIN: -0 }
+        );
+        expect(output.ZDECF16_MIN).toEqual(0);
+        expect(output.ZDECF34_MIN).toEqual(0);
+
+        // rounded to zero, no sign
+        output = await echo(
+            { bcd: { scale: 2 } },
+            { ZDECF34_MIN: "-0.004", ZDECF34_MAX: "-0E+5" }
+        );
+        expect(output.ZDECF34_MIN).toEqual(BigInt(0));
+        expect(output.ZDECF34_MAX).toEqual(BigInt(0));
+    });
+
+    test("exponent forms read as number and scaled BigInt", async () => {
+        expect.assertions(6);
+        let output = await echo(
+            { bcd: "number" },
+            { ZDECF34_MIN: "1.5E+3", ZDECF34_MAX: "-2.5e-7" }
+        );
+        expect(output.ZDECF34_MIN).toEqual(1500);
+        expect(output.ZDECF34_MAX).toEqual(-2.5e-7);
+
+        output = await echo(
+            { bcd: { scale: 4 } },
+            { ZDECF34_MIN: "1.23456E+2", ZDECF34_MAX: "-7e-4" }
+        );
+        expect(output.ZDECF34_MIN).toEqual(BigInt(1234560));
+        expect(output.ZDECF34_MAX).toEqual(BigInt(-7));
+
+        output = await echo(
+            { bcd: "number" },
+            {
+                ZDECF16_MIN: RFC_MATH.DECF16.POS.MIN,
+                ZDECF16_MAX: RFC_MATH.DECF16.NEG.MAX,
+            }
+        );
+        expect(output.ZDECF16_MIN).toEqual(Number(RFC_MATH.DECF16.POS.MIN));
+        expect(output.ZDECF16_MAX).toEqual(Number(RFC_MATH.DECF16.NEG.MAX));
+    });
+
+    test("rounding half away from zero at the scale boundary", async () => {
+        const values: [string, bigint][] = [
+            ["0.125", BigInt(13)],
+            ["-0.125", BigInt(-13)],
+            ["0.124999", BigInt(12)],
+            ["-0.124999", BigInt(-12)],
+            ["0.995", BigInt(100)],
+            ["-0.005", BigInt(-1)],
+            ["5E-3", BigInt(1)],
+            ["4.9999E-3", BigInt(0)],
+            ["99999999999999999999.995", BigInt("10000000000000000000000")],
+        ];
+        expect.assertions(values.length);
+        for (const [value, scaled] of values) {
+            const output = await echo(
+                { bcd: { scale: 2 } },
+                { ZDECF34_MIN: value }
+            );
+            expect(output.ZDECF34_MIN).toEqual(scaled);
+        }
+    });
+
+    test("DECF34 maximum precision", async () => {
+        expect.assertions(5);
+        const digits = "1234567890123456789012345678901234";
+        let output = await echo(
+            { bcd: { scale: 3 } },
+            {
+                ZDECF34_MIN: "1234567890123456789012345678901.234",
+                // scaled back by 10^3
+                ZDECF34_MAX: -BigInt("9".repeat(34)),
+            }
+        );
+        expect(output.ZDECF34_MIN).toEqual(BigInt(digits));
+        expect(output.ZDECF34_MAX).toEqual(-BigInt("9".repeat(34)));
+
+        output = await echo(
+            { bcd: "scaledBigInt" },
+            {
+                ZDECF34_MIN: RFC_MATH.DECF34.POS.MAX,
+                ZDECF34_MAX: RFC_MATH.DECF34.NEG.MIN,
+            }
+        );
+        // DECF34 field has no decimals, integer value returned
+        expect(output.ZDECF34_MIN).toEqual(
+            BigInt("9".repeat(34) + "0".repeat(6111))
+        );
+        expect(output.ZDECF34_MAX).toEqual(BigInt(0));
+
+        output = await echo(
+            { bcd: "number" },
+            { ZDECF34_MIN: "1234567890123456789012345678901.234" }
+        );
+        expect(output.ZDECF34_MIN).toEqual(
+            Number("1234567890123456789012345678901.234")
+        );
+    });
+});
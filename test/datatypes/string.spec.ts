@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { direct_client, RfcObject, RfcStructure } from "../utils/setup";
+
+describe("Datatypes: CHAR and STRING conversion", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    async function echo(text: string): Promise<string> {
+        const res = (await client.call("STFC_CONNECTION", {
+            REQUTEXT: text,
+        })) as RfcObject;
+        return res.ECHOTEXT as string;
+    }
+
+    test("ASCII lengths around vector steps", async () => {
+        // 8 and 16 characters are converted per step, remainder one by one
+        const lengths = [1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 50, 255];
+        expect.assertions(lengths.length);
+        for (const length of lengths) {
+            const text = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+                .repeat(8)
+                .substring(0, length);
+            expect(await echo(text)).toEqual(text);
+        }
+    });
+
+    test("trailing blanks trimmed at lane boundaries", async () => {
+        const texts = [
+            "A".repeat(7) + " ",
+            "A".repeat(8) + " ".repeat(8),
+            "A".repeat(9) + " ".repeat(7),
+            "A".repeat(15) + " ",
+            "A".repeat(16) + " ".repeat(16),
+            "A".repeat(17) + " ".repeat(15),
+        ];
+        expect.assertions(texts.length);
+        for (const text of texts) {
+            // CHAR field is blank padded, trailing blanks are not returned
+            expect(await echo(text)).toEqual(text.trimEnd());
+        }
+    });
+
+    test("inner blanks kept across lane boundaries", async () => {
+        const texts = [
+            "A" + " ".repeat(7) + "B",
+            "A" + " ".repeat(15) + "B",
+            "A" + " ".repeat(16) + "B",
+            " ".repeat(16) + "B",
+        ];
+        expect.assertions(texts.length);
+        for (const text of texts) {
+            expect(await echo(text)).toEqual(text);
+        }
+    });
+
+    test("non-ASCII characters before, at and after lane boundaries", async () => {
+        const texts: string[] = [];
+        for (const position of [0, 7, 8, 15, 16, 17]) {
+            // two and three bytes UTF-8, surrogate pair
+            for (const char of ["ä", "€", "ท", "😀"]) {
+                texts.push(
+                    "A".repeat(position) + char + "B".repeat(20 - position)
+                );
+            }
+        }
+        expect.assertions(texts.length);
+        for (const text of texts) {
+            expect(await echo(text)).toEqual(text);
+        }
+    });
+
+    test("non-ASCII followed by trailing blanks", async () => {
+        const texts = ["ä" + " ".repeat(16), "A".repeat(16) + "€" + "   "];
+        expect.assertions(texts.length);
+        for (const text of texts) {
+            expect(await echo(text)).toEqual(text.trimEnd());
+        }
+    });
+
+    test("structure and table CHAR fields", async () => {
+        expect.assertions(3);
+        const importStruct = {
+            RFCDATA1: "Äb" + "c".repeat(45) + "  ",
+            RFCCHAR4: "A  ",
+        };
+        const res = (await client.call("STFC_STRUCTURE", {
+            IMPORTSTRUCT: importStruct,
+            RFCTABLE: [importStruct],
+        })) as RfcObject;
+        const echoStruct = res.ECHOSTRUCT as RfcStructure;
+        expect(echoStruct.RFCDATA1).toEqual(importStruct.RFCDATA1.trimEnd());
+        expect(echoStruct.RFCCHAR4).toEqual("A");
+        expect((res.RFCTABLE as RfcStructure[])[0].RFCDATA1).toEqual(
+            importStruct.RFCDATA1.trimEnd()
+        );
+    });
+});
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import {
+    direct_client,
+    RfcTable,
+    RfcStructure,
+    RfcTableColumns,
+    RfcTableOfStructures,
+} from "../utils/setup";
+
+describe("Datatypes: tables", () => {
+    const client = direct_client();
+
+    beforeAll(() => {
+        return client.open();
+    });
+
+    afterAll(() => {
+        return client.close();
+    });
+
+    test("Table rows are returned in ABAP table order", async () => {
+        const COUNT = 100;
+        expect.assertions(COUNT + 1);
+        const importTable = [] as RfcTable;
+        for (let i = 0; i < COUNT; i++) {
+            importTable.push({ RFCINT4: i, RFCCHAR4: `R${i}` });
+        }
+        const res = await client.call("STFC_STRUCTURE", {
+            RFCTABLE: importTable,
+        });
+        const rfcTable = res.RFCTABLE as RfcTable;
+        // one row appended by STFC_STRUCTURE
+        expect(rfcTable.length).toEqual(COUNT + 1);
+        for (let i = 0; i < COUNT; i++) {
+            expect((rfcTable[i] as RfcStructure).RFCINT4).toEqual(i);
+        }
+    });
+
+    test("Large table converted completely", async () => {
+        const COUNT = 100000;
+        expect.assertions(3);
+        const res = await client.call("STFC_PERFORMANCE", {
+            CHECKTAB: "X",
+            LGET0332: COUNT.toString(),
+            LGET1000: "0",
+        });
+        const etab = res.ETAB0332 as RfcTable;
+        expect(etab.length).toEqual(COUNT);
+        expect(etab[0]).toBeDefined();
+        expect(etab[COUNT - 1]).toBeDefined();
+    }, 60000);
+
+    test("Table returned as columns", async () => {
+        expect.assertions(6);
+        const columnsClient = direct_client("MME", { table: "columns" });
+        await columnsClient.open();
+        const res = await columnsClient.call("STFC_STRUCTURE", {
+            RFCTABLE: [
+                { RFCINT4: 1, RFCFLOAT: 1.5, RFCCHAR4: "A" },
+                { RFCINT4: 2, RFCFLOAT: 2.5, RFCCHAR4: "B" },
+            ],
+        });
+        await columnsClient.close();
+        const columns = res.RFCTABLE as RfcTableColumns;
+        expect(columns.RFCINT4).toBeInstanceOf(Int32Array);
+        expect(columns.RFCFLOAT).toBeInstanceOf(Float64Array);
+        expect(Array.isArray(columns.RFCCHAR4)).toBe(true);
+        expect(Array.from(columns.RFCINT4).slice(0, 2)).toEqual([1, 2]);
+        expect(Array.from(columns.RFCFLOAT).slice(0, 2)).toEqual([1.5, 2.5]);
+        expect((columns.RFCCHAR4 as RfcTable).slice(0, 2)).toEqual([
+            "A",
+            "B",
+        ]);
+    });
+
+    test("Table sent as columns", async () => {
+        expect.assertions(5);
+        const res = await client.call("STFC_STRUCTURE", {
+            RFCTABLE: {
+                RFCINT4: Int32Array.from([1, 2]),
+                RFCFLOAT: Float64Array.from([1.5, 2.5]),
+                RFCCHAR4: Buffer.from("A   B   "),
+                RFCDATE: ["20240101", "20240102"],
+            },
+        });
+        const rfcTable = res.RFCTABLE as RfcTableOfStructures;
+        // one row appended by STFC_STRUCTURE
+        expect(rfcTable.length).toEqual(3);
+        expect(rfcTable.map((row) => row.RFCINT4).slice(0, 2)).toEqual([1, 2]);
+        expect(rfcTable.map((row) => row.RFCFLOAT).slice(0, 2)).toEqual([
+            1.5, 2.5,
+        ]);
+        expect(rfcTable.map((row) => row.RFCCHAR4).slice(0, 2)).toEqual([
+            "A",
+            "B",
+        ]);
+        expect(rfcTable.map((row) => row.RFCDATE).slice(0, 2)).toEqual([
+            "20240101",
+            "20240102",
+        ]);
+    });
+
+    test("Table columns of unequal length rejected", async () => {
+        expect.assertions(1);
+        await expect(
+            client.call("STFC_STRUCTURE", {
+                RFCTABLE: {
+                    RFCINT4: Int32Array.from([1, 2]),
+                    RFCCHAR4: ["A"],
+                },
+            })
+        ).rejects.toMatchObject({
+            name: "nodeRfcError",
+            message:
+                "Table columns of equal length expected from NodeJS, got 1 instead of 2",
+        });
+    });
+
+    test("Non-ASCII Buffer column of CHAR field rejected", async () => {
+        expect.assertions(1);
+        await expect(
+            client.call("STFC_STRUCTURE", {
+                RFCTABLE: {
+                    // "ä" is two bytes in UTF-8
+                    RFCCHAR4: Buffer.from("A   Bä "),
+                },
+            })
+        ).rejects.toMatchObject({
+            name: "nodeRfcError",
+            message:
+                "ASCII Buffer expected from NodeJS, for ABAP table column of type 0",
+            rfmPath: { field: "RFCCHAR4", table_line: 1 },
+        });
+    });
+
+    test("Table option value checked", () => {
+        expect.assertions(2);
+        expect(() =>
+            direct_client("MME", { table: "cols" as "columns" })
+        ).toThrow(
+            new TypeError('Client option "table" value not allowed: "cols"')
+        );
+        expect(() =>
+            direct_client("MME", { table: ["columns"] as unknown as "columns" })
+        ).toThrow(
+            new TypeError('Client option "table" value not allowed: "object"')
+        );
+    });
+});
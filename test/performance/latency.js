@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//
+// Client call() latency, p50 and p99, with concurrent clients calling
+// STFC_CONNECTION. Run by latency.sh, with SDK stub from sdkstub.cc.
+//
+//   node test/performance/latency.js cached|uncached
+//
+// uncached: function description invalidated before each call, the call
+//           takes PrepareAsync and InvokeAsync worker jobs, like before
+//           single job invoke
+// cached:   description found in cache, one InvokeAsync worker job
+//
+// CLIENTS (default 8) clients make CALLS (default 1000) calls each.
+//
+
+const { Client, invalidateFunctionDescription } = require("../../lib");
+
+const mode = process.argv[2] || "cached";
+const CLIENTS = Number(process.env.CLIENTS || 8);
+const CALLS = Number(process.env.CALLS || 1000);
+const RFM = "STFC_CONNECTION";
+
+function percentile(sorted, p) {
+    return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+async function calls(client, latencies) {
+    for (let i = 0; i < CALLS; i++) {
+        if (mode === "uncached") {
+            invalidateFunctionDescription(RFM);
+        }
+        const start = process.hrtime.bigint();
+        await client.call(RFM, { REQUTEXT: `latency ${i}` });
+        latencies.push(Number(process.hrtime.bigint() - start) / 1000);
+    }
+}
+
+async function main() {
+    const clients = [];
+    for (let i = 0; i < CLIENTS; i++) {
+        const client = new Client({ dest: "STUB" });
+        await client.open();
+        // warm-up, description cached and system ID known
+        await client.call(RFM, { REQUTEXT: "warm-up" });
+        clients.push(client);
+    }
+
+    const latencies = [];
+    const start = process.hrtime.bigint();
+    await Promise.all(clients.map((client) => calls(client, latencies)));
+    const elapsed = Number(process.hrtime.bigint() - start) / 1e9;
+    await Promise.all(clients.map((client) => client.close()));
+
+    latencies.sort((a, b) => a - b);
+    console.log(
+        `${mode}: ${CLIENTS} clients x ${CALLS} calls, ` +
+            `p50 ${percentile(latencies, 0.5).toFixed(0)} us, ` +
+            `p99 ${percentile(latencies, 0.99).toFixed(0)} us, ` +
+            `${(latencies.length / elapsed).toFixed(0)} calls/s`
+    );
+}
+
+main().catch((err) => {
+    console.error(err);
+    process.exit(1);
+});
@@ -0,0 +1,29 @@
+#!/bin/sh
+# SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Builds the SAP NW RFC SDK link stub, with SDK headers from SAPNWRFC_HOME,
+# and measures client call latency with and without the cached single job
+# invoke. The addon and lib must be built, "npm run build". Run from the
+# repository root.
+#
+# NODE_RFC_STUB_DELAY_US sets the simulated network delay, CLIENTS and
+# CALLS the load, see latency.js.
+
+set -e
+
+SDK="${SAPNWRFC_HOME:?SAPNWRFC_HOME not set}"
+OUT=build/bench/sdkstub
+mkdir -p "$OUT"
+
+g++ -std=c++17 -O2 -shared -fPIC \
+    -DSAPwithUNICODE -DSAPonLIN -DSAPonUNIX -DSAPwithTHREADS \
+    -I"$SDK/include" test/performance/sdkstub.cc -o "$OUT/libsapnwrfc.so"
+# the addon links libsapucum too, not used by the stub
+g++ -shared -fPIC -x c++ /dev/null -o "$OUT/libsapucum.so"
+
+# stub found before the SDK libraries, the addon RUNPATH
+for mode in uncached cached; do
+    LD_LIBRARY_PATH="$OUT" node test/performance/latency.js "$mode"
+done
@@ -0,0 +1,538 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//
+// Link stub of SAP NW RFC SDK, for latency measurements without ABAP
+// system. Built as libsapnwrfc.so by latency.sh and loaded instead of
+// the SDK, via LD_LIBRARY_PATH.
+//
+// Only STFC_CONNECTION is known. RfcInvoke and RfcPing sleep for
+// NODE_RFC_STUB_DELAY_US microseconds, default 1000, simulating the
+// network round trip, and echo REQUTEXT to ECHOTEXT. SDK functions not
+// used by the client call path are not implemented.
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "sapnwrfc.h"
+
+namespace {
+
+typedef std::vector<SAP_UC> UcString;
+
+const unsigned CHAR_LENGTH = 255;
+
+struct Parameter {
+  const char* name;
+  RFC_DIRECTION direction;
+};
+
+const Parameter STFC_CONNECTION[] = {
+    {"REQUTEXT", RFC_IMPORT},
+    {"ECHOTEXT", RFC_EXPORT},
+    {"RESPTEXT", RFC_EXPORT},
+};
+const unsigned PARAMETER_COUNT = 3;
+
+struct FunctionDesc {
+  UcString name;
+};
+
+struct Function {
+  FunctionDesc* desc;
+  UcString values[PARAMETER_COUNT];
+};
+
+struct Connection {
+  bool open;
+};
+
+// Removed descriptors are kept, still used by functions created before
+std::mutex repositoryMutex;
+FunctionDesc* functionDesc = nullptr;
+std::vector<std::unique_ptr<FunctionDesc>> removedDescs;
+
+UcString ucString(const char* ascii) {
+  UcString uc;
+  while (*ascii) {
+    uc.push_back((SAP_UC)*ascii++);
+  }
+  uc.push_back(0);
+  return uc;
+}
+
+bool ucEquals(const SAP_UC* uc, const char* ascii) {
+  while (*ascii && *uc == (SAP_UC)*ascii) {
+    uc++;
+    ascii++;
+  }
+  return *uc == 0 && *ascii == 0;
+}
+
+void ucCopy(SAP_UC* target, const char* ascii, unsigned size) {
+  unsigned i = 0;
+  for (; ascii[i] && i + 1 < size; i++) {
+    target[i] = (SAP_UC)ascii[i];
+  }
+  target[i] = 0;
+}
+
+RFC_RC ok(RFC_ERROR_INFO* errorInfo) {
+  if (errorInfo != nullptr) {
+    errorInfo->code = RFC_OK;
+    errorInfo->group = OK;
+    errorInfo->key[0] = 0;
+    errorInfo->message[0] = 0;
+  }
+  return RFC_OK;
+}
+
+RFC_RC fail(RFC_ERROR_INFO* errorInfo,
+            RFC_RC rc,
+            RFC_ERROR_GROUP group,
+            const char* key,
+            const char* message) {
+  if (errorInfo != nullptr) {
+    memset(errorInfo, 0, sizeof(RFC_ERROR_INFO));
+    errorInfo->code = rc;
+    errorInfo->group = group;
+    ucCopy(errorInfo->key, key, sizeof(errorInfo->key) / sizeof(SAP_UC));
+    ucCopy(errorInfo->message,
+           message,
+           sizeof(errorInfo->message) / sizeof(SAP_UC));
+  }
+  return rc;
+}
+
+int parameterIndex(const SAP_UC* name) {
+  for (unsigned i = 0; i < PARAMETER_COUNT; i++) {
+    if (ucEquals(name, STFC_CONNECTION[i].name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void setChars(Function* function,
+              unsigned index,
+              const SAP_UC* value,
+              unsigned length) {
+  // CHAR field, truncated or blank padded
+  UcString& field = function->values[index];
+  field.assign(CHAR_LENGTH, (SAP_UC)' ');
+  for (unsigned i = 0; i < length && i < CHAR_LENGTH; i++) {
+    field[i] = value[i];
+  }
+}
+
+void delay() {
+  static const long delayUs = [] {
+    const char* value = getenv("NODE_RFC_STUB_DELAY_US");
+    return value != nullptr ? atol(value) : 1000L;
+  }();
+  std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+}
+
+}  // namespace
+
+//
+// Versions, errors and conversions
+//
+
+const SAP_UC* RfcGetVersion(unsigned* major,
+                            unsigned* minor,
+                            unsigned* patchLevel) {
+  static const UcString version = ucString("7500.0.0 stub");
+  *major = 7500;
+  *minor = 0;
+  *patchLevel = 0;
+  return version.data();
+}
+
+const SAP_UC* RfcGetRcAsString(RFC_RC rc) {
+  static const UcString ok = ucString("RFC_OK");
+  static const UcString notFound = ucString("RFC_NOT_FOUND");
+  static const UcString invalidHandle = ucString("RFC_INVALID_HANDLE");
+  static const UcString invalidParameter = ucString("RFC_INVALID_PARAMETER");
+  static const UcString other = ucString("RFC_UNKNOWN_ERROR");
+  switch (rc) {
+    case RFC_OK:
+      return ok.data();
+    case RFC_NOT_FOUND:
+      return notFound.data();
+    case RFC_INVALID_HANDLE:
+      return invalidHandle.data();
+    case RFC_INVALID_PARAMETER:
+      return invalidParameter.data();
+    default:
+      return other.data();
+  }
+}
+
+RFC_RC RfcSAPUCToUTF8(const SAP_UC* sapuc,
+                      unsigned sapucLength,
+                      RFC_BYTE* utf8,
+                      unsigned* utf8BufferLength,
+                      unsigned* resultLength,
+                      RFC_ERROR_INFO* errorInfo) {
+  std::vector<RFC_BYTE> bytes;
+  for (unsigned i = 0; i < sapucLength; i++) {
+    unsigned c = sapuc[i];
+    if (c >= 0xD800 && c < 0xDC00 && i + 1 < sapucLength) {
+      c = 0x10000 + ((c - 0xD800) << 10) + (sapuc[++i] - 0xDC00);
+    }
+    if (c < 0x80) {
+      bytes.push_back(c);
+    } else if (c < 0x800) {
+      bytes.push_back(0xC0 | (c >> 6));
+      bytes.push_back(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      bytes.push_back(0xE0 | (c >> 12));
+      bytes.push_back(0x80 | ((c >> 6) & 0x3F));
+      bytes.push_back(0x80 | (c & 0x3F));
+    } else {
+      bytes.push_back(0xF0 | (c >> 18));
+      bytes.push_back(0x80 | ((c >> 12) & 0x3F));
+      bytes.push_back(0x80 | ((c >> 6) & 0x3F));
+      bytes.push_back(0x80 | (c & 0x3F));
+    }
+  }
+  *resultLength = bytes.size();
+  if (bytes.size() > *utf8BufferLength) {
+    *utf8BufferLength = bytes.size() + 1;
+    return fail(errorInfo,
+                RFC_BUFFER_TOO_SMALL,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_BUFFER_TOO_SMALL",
+                "UTF-8 buffer too small");
+  }
+  memcpy(utf8, bytes.data(), bytes.size());
+  if (bytes.size() < *utf8BufferLength) {
+    utf8[bytes.size()] = 0;
+  }
+  return ok(errorInfo);
+}
+
+RFC_RC RfcUTF8ToSAPUC(const RFC_BYTE* utf8,
+                      unsigned utf8Length,
+                      SAP_UC* sapuc,
+                      unsigned* sapucSize,
+                      unsigned* resultLength,
+                      RFC_ERROR_INFO* errorInfo) {
+  UcString uc;
+  for (unsigned i = 0; i < utf8Length;) {
+    unsigned c = utf8[i++];
+    unsigned follow = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+    c &= follow == 0 ? 0x7F : 0x3F >> follow;
+    for (; follow > 0 && i < utf8Length; follow--) {
+      c = (c << 6) | (utf8[i++] & 0x3F);
+    }
+    if (c >= 0x10000) {
+      c -= 0x10000;
+      uc.push_back(0xD800 + (c >> 10));
+      uc.push_back(0xDC00 + (c & 0x3FF));
+    } else {
+      uc.push_back(c);
+    }
+  }
+  *resultLength = uc.size();
+  if (uc.size() >= *sapucSize) {
+    *sapucSize = uc.size() + 1;
+    return fail(errorInfo,
+                RFC_BUFFER_TOO_SMALL,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_BUFFER_TOO_SMALL",
+                "SAP unicode buffer too small");
+  }
+  memcpy(sapuc, uc.data(), uc.size() * sizeof(SAP_UC));
+  sapuc[uc.size()] = 0;
+  return ok(errorInfo);
+}
+
+RFC_RC RfcSetIniPath(const SAP_UC*, RFC_ERROR_INFO* errorInfo) {
+  return ok(errorInfo);
+}
+
+RFC_RC RfcReloadIniFile(RFC_ERROR_INFO* errorInfo) {
+  return ok(errorInfo);
+}
+
+//
+// Connections
+//
+
+RFC_CONNECTION_HANDLE RfcOpenConnection(RFC_CONNECTION_PARAMETER const*,
+                                        unsigned,
+                                        RFC_ERROR_INFO* errorInfo) {
+  delay();
+  ok(errorInfo);
+  return reinterpret_cast<RFC_CONNECTION_HANDLE>(new Connection{true});
+}
+
+RFC_RC RfcCloseConnection(RFC_CONNECTION_HANDLE connectionHandle,
+                          RFC_ERROR_INFO* errorInfo) {
+  delete reinterpret_cast<Connection*>(connectionHandle);
+  return ok(errorInfo);
+}
+
+RFC_RC RfcIsConnectionHandleValid(RFC_CONNECTION_HANDLE connectionHandle,
+                                  int* isValid,
+                                  RFC_ERROR_INFO* errorInfo) {
+  *isValid = connectionHandle != nullptr;
+  return ok(errorInfo);
+}
+
+RFC_RC RfcPing(RFC_CONNECTION_HANDLE, RFC_ERROR_INFO* errorInfo) {
+  delay();
+  return ok(errorInfo);
+}
+
+RFC_RC RfcResetServerContext(RFC_CONNECTION_HANDLE,
+                             RFC_ERROR_INFO* errorInfo) {
+  return ok(errorInfo);
+}
+
+RFC_RC RfcCancel(RFC_CONNECTION_HANDLE, RFC_ERROR_INFO* errorInfo) {
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetConnectionAttributes(RFC_CONNECTION_HANDLE,
+                                  RFC_ATTRIBUTES* attributes,
+                                  RFC_ERROR_INFO* errorInfo) {
+  memset(attributes, 0, sizeof(RFC_ATTRIBUTES));
+  ucCopy(attributes->dest, "STUB", 65);
+  ucCopy(attributes->host, "localhost", 101);
+  ucCopy(attributes->partnerHost, "localhost", 101);
+  ucCopy(attributes->sysNumber, "00", 3);
+  ucCopy(attributes->sysId, "STB", 9);
+  ucCopy(attributes->client, "001", 4);
+  ucCopy(attributes->user, "STUB", 13);
+  ucCopy(attributes->language, "E", 3);
+  ucCopy(attributes->isoLanguage, "EN", 3);
+  ucCopy(attributes->codepage, "4103", 5);
+  ucCopy(attributes->partnerCodepage, "4103", 5);
+  ucCopy(attributes->rfcRole, "C", 2);
+  ucCopy(attributes->type, "E", 2);
+  ucCopy(attributes->partnerType, "3", 2);
+  ucCopy(attributes->rel, "753", 5);
+  ucCopy(attributes->partnerRel, "757", 5);
+  ucCopy(attributes->kernelRel, "753", 5);
+  return ok(errorInfo);
+}
+
+//
+// Function descriptors, one per name like in the SDK repository
+//
+
+RFC_FUNCTION_DESC_HANDLE RfcGetFunctionDesc(RFC_CONNECTION_HANDLE,
+                                            SAP_UC const* funcName,
+                                            RFC_ERROR_INFO* errorInfo) {
+  if (!ucEquals(funcName, "STFC_CONNECTION")) {
+    fail(errorInfo,
+         RFC_NOT_FOUND,
+         ABAP_APPLICATION_FAILURE,
+         "FU_NOT_FOUND",
+         "ID:FL Type:E Number:046 STUB");
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(repositoryMutex);
+  if (functionDesc == nullptr) {
+    functionDesc = new FunctionDesc{ucString("STFC_CONNECTION")};
+  }
+  ok(errorInfo);
+  return reinterpret_cast<RFC_FUNCTION_DESC_HANDLE>(functionDesc);
+}
+
+RFC_RC RfcRemoveFunctionDesc(SAP_UC const*,
+                             SAP_UC const* funcName,
+                             RFC_ERROR_INFO* errorInfo) {
+  std::lock_guard<std::mutex> lock(repositoryMutex);
+  if (functionDesc == nullptr || !ucEquals(funcName, "STFC_CONNECTION")) {
+    return fail(errorInfo,
+                RFC_NOT_FOUND,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_NOT_FOUND",
+                "Function descriptor not found");
+  }
+  removedDescs.emplace_back(functionDesc);
+  functionDesc = nullptr;
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetFunctionName(RFC_FUNCTION_DESC_HANDLE funcDesc,
+                          RFC_ABAP_NAME funcName,
+                          RFC_ERROR_INFO* errorInfo) {
+  const UcString& name = reinterpret_cast<FunctionDesc*>(funcDesc)->name;
+  memcpy(funcName, name.data(), name.size() * sizeof(SAP_UC));
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetParameterCount(RFC_FUNCTION_DESC_HANDLE,
+                            unsigned* count,
+                            RFC_ERROR_INFO* errorInfo) {
+  *count = PARAMETER_COUNT;
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetParameterDescByIndex(RFC_FUNCTION_DESC_HANDLE,
+                                  unsigned index,
+                                  RFC_PARAMETER_DESC* paramDesc,
+                                  RFC_ERROR_INFO* errorInfo) {
+  if (index >= PARAMETER_COUNT) {
+    return fail(errorInfo,
+                RFC_INVALID_PARAMETER,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_INVALID_PARAMETER",
+                "Parameter index out of range");
+  }
+  memset(paramDesc, 0, sizeof(RFC_PARAMETER_DESC));
+  ucCopy(paramDesc->name, STFC_CONNECTION[index].name, 31);
+  paramDesc->type = RFCTYPE_CHAR;
+  paramDesc->direction = STFC_CONNECTION[index].direction;
+  paramDesc->nucLength = CHAR_LENGTH;
+  paramDesc->ucLength = CHAR_LENGTH * sizeof(SAP_UC);
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetParameterDescByName(RFC_FUNCTION_DESC_HANDLE funcDesc,
+                                 SAP_UC const* name,
+                                 RFC_PARAMETER_DESC* paramDesc,
+                                 RFC_ERROR_INFO* errorInfo) {
+  int index = parameterIndex(name);
+  if (index < 0) {
+    return fail(errorInfo,
+                RFC_INVALID_PARAMETER,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_INVALID_PARAMETER",
+                "Parameter not found");
+  }
+  return RfcGetParameterDescByIndex(funcDesc, index, paramDesc, errorInfo);
+}
+
+//
+// Function containers
+//
+
+RFC_FUNCTION_HANDLE RfcCreateFunction(RFC_FUNCTION_DESC_HANDLE funcDesc,
+                                      RFC_ERROR_INFO* errorInfo) {
+  Function* function = new Function();
+  function->desc = reinterpret_cast<FunctionDesc*>(funcDesc);
+  for (unsigned i = 0; i < PARAMETER_COUNT; i++) {
+    function->values[i].assign(CHAR_LENGTH, (SAP_UC)' ');
+  }
+  ok(errorInfo);
+  return reinterpret_cast<RFC_FUNCTION_HANDLE>(function);
+}
+
+RFC_RC RfcDestroyFunction(RFC_FUNCTION_HANDLE funcHandle,
+                          RFC_ERROR_INFO* errorInfo) {
+  delete reinterpret_cast<Function*>(funcHandle);
+  return ok(errorInfo);
+}
+
+RFC_FUNCTION_DESC_HANDLE RfcDescribeFunction(RFC_FUNCTION_HANDLE funcHandle,
+                                             RFC_ERROR_INFO* errorInfo) {
+  ok(errorInfo);
+  return reinterpret_cast<RFC_FUNCTION_DESC_HANDLE>(
+      reinterpret_cast<Function*>(funcHandle)->desc);
+}
+
+RFC_RC RfcSetParameterActive(RFC_FUNCTION_HANDLE,
+                             SAP_UC const*,
+                             int,
+                             RFC_ERROR_INFO* errorInfo) {
+  return ok(errorInfo);
+}
+
+RFC_RC RfcSetCharsByIndex(DATA_CONTAINER_HANDLE container,
+                          unsigned index,
+                          const RFC_CHAR* charValue,
+                          unsigned valueLength,
+                          RFC_ERROR_INFO* errorInfo) {
+  if (index >= PARAMETER_COUNT) {
+    return fail(errorInfo,
+                RFC_INVALID_PARAMETER,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_INVALID_PARAMETER",
+                "Parameter index out of range");
+  }
+  setChars(reinterpret_cast<Function*>(container),
+           index,
+           charValue,
+           valueLength);
+  return ok(errorInfo);
+}
+
+RFC_RC RfcSetStringByIndex(DATA_CONTAINER_HANDLE container,
+                           unsigned index,
+                           const SAP_UC* stringValue,
+                           unsigned valueLength,
+                           RFC_ERROR_INFO* errorInfo) {
+  return RfcSetCharsByIndex(
+      container, index, stringValue, valueLength, errorInfo);
+}
+
+RFC_RC RfcSetString(DATA_CONTAINER_HANDLE container,
+                    SAP_UC const* name,
+                    const SAP_UC* stringValue,
+                    unsigned valueLength,
+                    RFC_ERROR_INFO* errorInfo) {
+  return RfcSetCharsByIndex(
+      container, parameterIndex(name), stringValue, valueLength, errorInfo);
+}
+
+RFC_RC RfcGetCharsByIndex(DATA_CONTAINER_HANDLE container,
+                          unsigned index,
+                          RFC_CHAR* charBuffer,
+                          unsigned bufferLength,
+                          RFC_ERROR_INFO* errorInfo) {
+  if (index >= PARAMETER_COUNT) {
+    return fail(errorInfo,
+                RFC_INVALID_PARAMETER,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_INVALID_PARAMETER",
+                "Parameter index out of range");
+  }
+  const UcString& field = reinterpret_cast<Function*>(container)->values[index];
+  for (unsigned i = 0; i < bufferLength; i++) {
+    charBuffer[i] = i < field.size() ? field[i] : (SAP_UC)' ';
+  }
+  return ok(errorInfo);
+}
+
+RFC_RC RfcGetChars(DATA_CONTAINER_HANDLE container,
+                   SAP_UC const* name,
+                   RFC_CHAR* charBuffer,
+                   unsigned bufferLength,
+                   RFC_ERROR_INFO* errorInfo) {
+  return RfcGetCharsByIndex(
+      container, parameterIndex(name), charBuffer, bufferLength, errorInfo);
+}
+
+//
+// Remote call
+//
+
+RFC_RC RfcInvoke(RFC_CONNECTION_HANDLE connectionHandle,
+                 RFC_FUNCTION_HANDLE funcHandle,
+                 RFC_ERROR_INFO* errorInfo) {
+  if (connectionHandle == nullptr || funcHandle == nullptr) {
+    return fail(errorInfo,
+                RFC_INVALID_HANDLE,
+                EXTERNAL_RUNTIME_FAILURE,
+                "RFC_INVALID_HANDLE",
+                "Invalid connection or function handle");
+  }
+  delay();
+  Function* function = reinterpret_cast<Function*>(funcHandle);
+  function->values[1] = function->values[0];
+  UcString response = ucString("SDK stub");
+  setChars(function, 2, response.data(), response.size() - 1);
+  return ok(errorInfo);
+}
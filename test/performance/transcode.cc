@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+//
+// Microbenchmark: transcodeToUtf8/transcodeToSAPUC vs SAP NW RFC SDK
+// conversion with trailing whitespaces trimming, as used before.
+//
+// Built and run by "npm run bench:transcode", see transcode.sh, once with
+// the SSE2 loops and once with NODE_RFC_SCALAR for the scalar loops.
+//
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Transcode.h"
+
+using namespace node_rfc;
+
+namespace {
+
+const int ROUNDS = 200000;
+
+uint_t sdkToUtf8(const SAP_UC* uc, uint_t length, RFC_BYTE* utf8) {
+  RFC_ERROR_INFO errorInfo;
+  uint_t utf8Size = length * 3;
+  uint_t resultLen = 0;
+  RfcSAPUCToUTF8(uc, length, utf8, &utf8Size, &resultLen, &errorInfo);
+  while (resultLen > 0 && isspace(utf8[resultLen - 1])) {
+    resultLen--;
+  }
+  return resultLen;
+}
+
+uint_t sdkToSAPUC(const RFC_BYTE* utf8, uint_t length, SAP_UC* uc) {
+  RFC_ERROR_INFO errorInfo;
+  uint_t ucSize = length + 1;
+  uint_t resultLen = 0;
+  RfcUTF8ToSAPUC(utf8, length, uc, &ucSize, &resultLen, &errorInfo);
+  return resultLen;
+}
+
+template <typename F>
+double measure(F f) {
+  auto start = std::chrono::steady_clock::now();
+  size_t sum = 0;
+  for (int i = 0; i < ROUNDS; i++) {
+    sum += f();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (sum == 0) {
+    printf("unexpected empty result\n");
+  }
+  return elapsed.count() / ROUNDS;
+}
+
+void run(const char* label, const std::string& text, uint_t width) {
+  // CHAR field, blank padded
+  std::vector<SAP_UC> uc(width + 1, cU(' '));
+  std::vector<RFC_BYTE> utf8(width * 3 + 1);
+  RFC_ERROR_INFO errorInfo;
+  uint_t ucSize = width;
+  uint_t ucLength = 0;
+  RfcUTF8ToSAPUC(reinterpret_cast<const RFC_BYTE*>(text.data()),
+                 static_cast<uint_t>(text.length()),
+                 uc.data(),
+                 &ucSize,
+                 &ucLength,
+                 &errorInfo);
+  for (uint_t i = ucLength; i < width; i++) {
+    uc[i] = cU(' ');
+  }
+
+  double sdk = measure([&]() { return sdkToUtf8(uc.data(), width, &utf8[0]); });
+  double fast = measure([&]() {
+    uint_t length = 0;
+    if (!transcodeToUtf8(uc.data(), width, &utf8[0], &length)) {
+      length = sdkToUtf8(uc.data(), width, &utf8[0]);
+    }
+    return length;
+  });
+  printf("%-24s to UTF-8   sdk %8.1f ns  fast %8.1f ns  x%.1f\n",
+         label,
+         sdk,
+         fast,
+         sdk / fast);
+
+  const RFC_BYTE* in = reinterpret_cast<const RFC_BYTE*>(text.data());
+  uint_t length = static_cast<uint_t>(text.length());
+  sdk = measure([&]() { return sdkToSAPUC(in, length, uc.data()); });
+  fast = measure([&]() {
+    uint_t resultLen = 0;
+    if (!transcodeToSAPUC(in, length, uc.data(), &resultLen)) {
+      resultLen = sdkToSAPUC(in, length, uc.data());
+    }
+    return resultLen;
+  });
+  printf("%-24s to SAP UC  sdk %8.1f ns  fast %8.1f ns  x%.1f\n",
+         label,
+         sdk,
+         fast,
+         sdk / fast);
+}
+
+}  // namespace
+
+int main() {
+  run("ASCII CHAR10", "MATNR", 10);
+  run("ASCII CHAR40", "Customer order 4711", 40);
+  run("ASCII CHAR255", std::string(200, 'X'), 255);
+  run("Latin-1 CHAR40", "B\xc3\xa4" "ckerei M\xc3\xbc" "ller", 40);
+  run("Cyrillic CHAR40", "\xd0\x97\xd0\xb0\xd0\xba\xd0\xb0\xd0\xb7", 40);
+  return 0;
+}
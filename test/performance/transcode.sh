@@ -0,0 +1,31 @@
+#!/bin/sh
+# SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Builds and runs the transcode microbenchmark, SSE2 and scalar loops,
+# with SAP NW RFC SDK from SAPNWRFC_HOME. Run from the repository root.
+
+set -e
+
+SDK="${SAPNWRFC_HOME:?SAPNWRFC_HOME not set}"
+NODE_INCLUDE="$(node -p "require('path').resolve(process.execPath, '../../include/node')")"
+NAPI_INCLUDE="$(node -p "require('node-addon-api').include_dir")"
+OUT=build/bench
+mkdir -p "$OUT"
+
+for variant in sse2 scalar; do
+    flags=""
+    if [ "$variant" = scalar ]; then
+        flags="-DNODE_RFC_SCALAR"
+    fi
+    g++ -std=c++17 -O2 $flags \
+        -DSAPwithUNICODE -DSAPonLIN -DSAPonUNIX -DSAPwithTHREADS \
+        -DNAPI_VERSION=8 -DNAPI_CPP_EXCEPTIONS \
+        -I"$SDK/include" -I"$NAPI_INCLUDE" -I"$NODE_INCLUDE" -Isrc/cpp \
+        test/performance/transcode.cc src/cpp/Transcode.cc \
+        -L"$SDK/lib" -lsapnwrfc -lsapucum -Wl,-rpath,"$SDK/lib" \
+        -o "$OUT/transcode-$variant"
+    echo "$variant"
+    "$OUT/transcode-$variant"
+done
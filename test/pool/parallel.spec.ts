@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2014 SAP SE Srdjan Boskovic <srdjan.boskovic@sap.com>
+//
+// SPDX-License-Identifier: Apache-2.0
+
+import { Pool, RfcBatchResult, poolConfiguration } from "../utils/setup";
+
+describe("Pool: invokeParallel()", () => {
+    const pool = new Pool({
+        ...poolConfiguration,
+        poolOptions: { low: 0, high: 4 },
+    });
+
+    afterAll(() => {
+        return pool.closeAll();
+    });
+
+    test("Results returned in call order", async () => {
+        const CALLS = 20;
+        expect.assertions(CALLS + 3);
+        const results = (await pool.invokeParallel(
+            [...Array(CALLS).keys()].map((i) => ({
+                rfm: "STFC_CONNECTION",
+                params: { REQUTEXT: `call ${i}` },
+            })),
+            { concurrency: 3 }
+        )) as RfcBatchResult[];
+        expect(results.length).toBe(CALLS);
+        results.forEach((item, i) => {
+            expect(item.result?.ECHOTEXT).toBe(`call ${i}`);
+        });
+        // connections returned to pool
+        expect(pool.status.leased).toBe(0);
+        expect(pool.status.ready).toBe(3);
+    });
+
+    test("Failed call does not stop other calls", (done) => {
+        expect.assertions(4);
+        pool.invokeParallel(
+            [
+                { rfm: "STFC_CONNECTION", params: { REQUTEXT: "first" } },
+                { rfm: "STFC_CONNECTION", params: { XXX: "wrong param" } },
+                { rfm: "STFC_CONNECTION", params: { REQUTEXT: "last" } },
+            ],
+            (err: unknown, results: RfcBatchResult[]) => {
+                expect(err).toBeUndefined();
+                expect(results[0].result?.ECHOTEXT).toBe("first");
+                expect(results[1].error).toEqual(
+                    expect.objectContaining({
+                        key: "RFC_INVALID_PARAMETER",
+                        message: "field 'XXX' not found",
+                    })
+                );
+                expect(results[2].result?.ECHOTEXT).toBe("last");
+                done();
+            }
+        );
+    });
+
+    test("Connections leased for prepared calls only", async () => {
+        expect.assertions(4);
+        const lanePool = new Pool({
+            ...poolConfiguration,
+            poolOptions: { low: 0, high: 4 },
+        });
+        const results = (await lanePool.invokeParallel(
+            [
+                { rfm: "STFC_CONNECTION", params: { REQUTEXT: "only" } },
+                { rfm: "STFC_CONNECTION", params: { XXX: 1 } },
+                { rfm: "STFC_CONNECTION", params: { XXX: 2 } },
+                { rfm: "STFC_CONNECTION", params: { XXX: 3 } },
+            ],
+            { concurrency: 4 }
+        )) as RfcBatchResult[];
+        expect(results[0].result?.ECHOTEXT).toBe("only");
+        expect(results[3].error).toBeDefined();
+        // one prepared call, one connection
+        expect(lanePool.status.leased).toBe(0);
+        expect(lanePool.status.ready).toBe(1);
+        await lanePool.closeAll();
+    });
+
+    test("Arguments checked", async () => {
+        expect.assertions(2);
+        await expect(
+            pool.invokeParallel([{ params: {} }] as unknown as [])
+        ).rejects.toThrow(
+            new TypeError(
+                "Pool invokeParallel() requires an array of {rfm, params} objects"
+            )
+        );
+        await expect(
+            pool.invokeParallel([], { concurrency: 0 })
+        ).rejects.toThrow(
+            new TypeError(
+                'Pool invokeParallel() option "concurrency" must be a positive integer. Received: 0'
+            )
+        );
+    });
+});
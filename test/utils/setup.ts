@@ -23,7 +23,12 @@ export {
     RfcArray,
     RfcTable,
     RfcStructure,
+    RfcTableColumns,
+    RfcTableOfStructures,
     RfcObject,
+    RfcBatchResult,
+    RfcClientOptions,
+    RfcLoggingLevel,
     NWRfcSdkError,
 } from "../../lib";
 